@@ -0,0 +1,49 @@
+/*
+Linked into each engine by run_bench.sh. Replaces the global operator new and delete
+to count allocations, and when the program ends reports the count, the bytes asked
+for, and the peak resident set size on stderr in one line starting with "bench:".
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <sys/resource.h>
+
+namespace {
+
+std::atomic<long> allocations {0};
+std::atomic<long> bytes {0};
+
+struct Report {
+  ~Report()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::fprintf(stderr, "bench: allocations %ld bytes %ld peak_rss_kb %ld\n",
+        allocations.load(), bytes.load(), long(usage.ru_maxrss));
+  }
+} report;
+
+}
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  bytes += size;
+  if (void* block = std::malloc(size ? size : 1)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept
+{
+  std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+  std::free(block);
+}
@@ -0,0 +1,133 @@
+#!/bin/bash
+# Run every golden transcript against every build in variants.txt. Prints one row per
+# run with the result (same or DIFFERS), the best wall-clock time over REPS runs, the
+# number of go commands, and the instructions per tick when perf is available. A time
+# more than THRESHOLD percent (and MIN_MS milliseconds) over the recorded one is
+# flagged SLOWER. Exits non-zero if any output differs or any run is slower.
+#
+# usage: check_transcripts.sh [--record] [variant...]
+#   --record   save the times of this run as the ones later runs are compared with
+# Set REPS (default 3), THRESHOLD (default 20), MIN_MS (default 5), BASELINE (default
+# build/transcript_times.txt) to change them.
+
+source "$(dirname "$0")/common.sh"
+
+reps=${REPS:-3}
+threshold=${THRESHOLD:-20}
+min_ms=${MIN_MS:-5}
+baseline=${BASELINE:-$build_dir/transcript_times.txt}
+
+record=0
+if [ "$1" == "--record" ]; then
+  record=1
+  shift
+fi
+selected="$*"
+
+# the golden input files of an engine; each X_in.txt has its output in X_out.txt, or in
+# X_out.<variant>.txt for a variant whose output is meant to differ
+transcripts() {
+  local dir=$(source_dir $1)
+  case $1 in
+    proj4) ls "$dir"/project4/samples/*_in.txt ;;
+    proj5) ls "$dir"/project5/samples/*_in.txt ;;
+    proj6) ls "$dir"/demo*_in.txt "$dir"/samples/*_in.txt 2> /dev/null ;;
+  esac
+}
+
+# run exe input output: sets best_ns to the fastest of the reps runs
+run() {
+  best_ns=
+  for ((rep = 0; rep < reps; ++rep)); do
+    local start=$(now_ns)
+    "$1" < "$2" > "$3" 2>&1
+    local elapsed=$(( $(now_ns) - start ))
+    if [ -z "$best_ns" ] || [ $elapsed -lt $best_ns ]; then
+      best_ns=$elapsed
+    fi
+  done
+}
+
+# without_commands commands: copy stdin to stdout, leaving out the prompts and output of
+# the commands that were run first
+without_commands() {
+  if [ "$1" == "-" ]; then
+    cat
+    return
+  fi
+  local count=$(echo "$1" | tr , '\n' | wc -l)
+  perl -0777 -pe 's/\A(.*?)(?:\nTime 0: Enter command: .*?){'$count'}(?=\nTime 0: Enter command: )/$1/s'
+}
+
+# instructions exe input: prints the user-mode instruction count, or nothing
+instructions() {
+  command -v perf > /dev/null || return
+  perf stat -x, -e instructions:u -o "$build_dir/perf.txt" -- "$1" < "$2" > /dev/null 2>&1 || return
+  awk -F, '$3 ~ /instructions/ && $1 ~ /^[0-9]+$/ { print $1 }' "$build_dir/perf.txt"
+}
+
+declare -A recorded
+if [ $record -eq 0 ] && [ -f "$baseline" ]; then
+  while read name ms; do
+    recorded[$name]=$ms
+  done < "$baseline"
+fi
+[ $record -eq 1 ] && : > "$baseline"
+
+failures=0
+printf "%-12s %-28s %-8s %10s %6s %14s\n" variant transcript result ms ticks instr/tick
+while read name engine flags commands; do
+  case $name in ''|\#*) continue ;; esac
+  if [ -n "$selected" ] && [[ " $selected " != *" $name "* ]]; then
+    continue
+  fi
+  exe=$build_dir/$name
+  [ "$flags" == "-" ] && flags=
+  build $engine "$exe" $flags
+  for input in $(transcripts $engine); do
+    golden=${input%_in.txt}_out.$name.txt
+    [ -f "$golden" ] || golden=${input%_in.txt}_out.txt
+    [ -f "$golden" ] || continue
+    transcript=$(basename "${input%_in.txt}")
+    if [ "$commands" == "-" ]; then
+      script=$input
+    else
+      script=$build_dir/$name.$transcript.in
+      echo "$commands" | tr , '\n' > "$script"
+      cat "$input" >> "$script"
+    fi
+
+    # run from the transcript's directory, so files it names (such as a scenario to
+    # load) are found
+    pushd "$(dirname "$input")" > /dev/null
+    run "$exe" "$script" "$build_dir/$name.$transcript.out"
+    ms=$(awk -v ns=$best_ns 'BEGIN { printf "%.2f", ns / 1e6 }')
+    result=same
+    if ! without_commands "$commands" < "$build_dir/$name.$transcript.out" | cmp -s - "$golden"; then
+      result=DIFFERS
+      failures=$((failures + 1))
+    fi
+    ticks=$(grep -cx "go" "$input")
+    count=$(instructions "$exe" "$script")
+    popd > /dev/null
+    per_tick=-
+    if [ -n "$count" ] && [ $ticks -gt 0 ]; then
+      per_tick=$((count / ticks))
+    fi
+
+    flag=
+    key=$name/$transcript
+    if [ $record -eq 1 ]; then
+      echo "$key $ms" >> "$baseline"
+    elif [ -n "${recorded[$key]}" ] && awk -v now=$ms -v then=${recorded[$key]} \
+        -v pct=$threshold -v floor=$min_ms \
+        'BEGIN { exit !(now > then * (1 + pct / 100) && now - then > floor) }'; then
+      flag="SLOWER than ${recorded[$key]} ms"
+      failures=$((failures + 1))
+    fi
+    printf "%-12s %-28s %-8s %10s %6s %14s%s\n" $name $transcript $result $ms $ticks $per_tick \
+        "${flag:+  $flag}"
+  done
+done < "$bench_dir/variants.txt"
+
+[ $failures -eq 0 ]
@@ -0,0 +1,26 @@
+# Shared by the bench scripts: where each engine's sources are, and how to build one.
+
+bench_dir=$(cd "$(dirname "$0")" && pwd)
+repo_dir=$(dirname "$bench_dir")
+build_dir=$bench_dir/build
+mkdir -p "$build_dir"
+
+source_dir() {
+  case $1 in
+    proj1) echo "$repo_dir/proj1" ;;
+    proj4) echo "$repo_dir/proj4" ;;
+    proj5) echo "$repo_dir/proj5" ;;
+    proj6) echo "$repo_dir/proj6/eecs381proj6/eecs381proj6" ;;
+  esac
+}
+
+# build engine output [extra compiler arguments...]
+build() {
+  local engine=$1 output=$2
+  shift 2
+  g++ -std=c++11 -O2 -pthread -w "$@" "$(source_dir $engine)"/*.cpp -o "$output" || exit 1
+}
+
+now_ns() {
+  date +%s%N
+}
@@ -0,0 +1,70 @@
+#!/bin/bash
+# Print a command script that every engine (proj4, proj5, proj6) accepts:
+# structures in Farm/Town_Hall pairs, peasants working between the two of a pair,
+# and soldiers trained in facing pairs that attack each other.
+#
+# usage: make_scenario.sh agents ticks views [seed]
+#   views 1 opens the map, health and amounts views and shows them after each tick;
+#   proj4 has only its map view and reports the open commands as unrecognized.
+
+agents=${1:-600}
+ticks=${2:-200}
+views=${3:-0}
+seed=${4:-1}
+
+awk -v agents="$agents" -v ticks="$ticks" -v views="$views" -v seed="$seed" '
+BEGIN {
+  srand(seed)
+  upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+  alnum = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+  # two-character prefixes of the objects every engine starts with
+  split("Ri Su Sh Pa Pi Me Zu Bu Ir", initial, " ")
+  for (i in initial) reserved[initial[i]] = 1
+  next_prefix = 0
+
+  pairs = int(agents / 40) + 1
+  for (i = 0; i < pairs; ++i) {
+    x = int(rand() * 60); y = int(rand() * 60)
+    farm[i] = new_name(); hall[i] = new_name()
+    print "build " farm[i] " Farm " x " " y
+    print "build " hall[i] " Town_Hall " x + 15 " " y + 10
+  }
+
+  peasants = int(agents / 2)
+  for (i = 0; i < peasants; ++i) {
+    name = new_name(); k = i % pairs
+    print "train " name " Peasant " int(rand() * 60) " " int(rand() * 60)
+    print name " work " farm[k] " " hall[k]
+  }
+
+  for (i = peasants; i + 1 < agents; i += 2) {
+    a = new_name(); b = new_name()
+    x = int(rand() * 60); y = int(rand() * 60)
+    print "train " a " Soldier " x " " y
+    print "train " b " Soldier " x + 1 " " y
+    print a " attack " b
+    print b " attack " a
+  }
+
+  if (views) {
+    print "open map"; print "open health"; print "open amounts"
+  }
+  for (t = 0; t < ticks; ++t) {
+    print "go"
+    if (views) print "show"
+  }
+  print "quit"
+}
+
+# a name whose first two characters no other object shares
+function new_name(   prefix) {
+  do {
+    if (next_prefix >= 26 * 62) {
+      print "make_scenario.sh: too many objects for unique name prefixes" > "/dev/stderr"
+      exit 1
+    }
+    prefix = substr(upper, int(next_prefix / 62) + 1, 1) substr(alnum, next_prefix % 62 + 1, 1)
+    ++next_prefix
+  } while (prefix in reserved)
+  return prefix next_prefix
+}'
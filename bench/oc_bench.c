@@ -0,0 +1,264 @@
+/* Benchmark driver for the proj1 Ordered_container implementations. Link it with
+ * one Ordered_container_*.c plus p1_globals.c, Utility.c and Person.c.
+ *
+ * usage: oc_bench order size [seed]
+ *   order  random, ascending, descending or skewed
+ *   size   number of items in the container
+ *
+ * The keys are the ints 0 .. size - 1. Each repetition inserts every key in the given
+ * order, finds every key, applies a function to every item, then finds and deletes
+ * every key in the insertion order. Small sizes are repeated so that each phase runs
+ * at least REPEAT_OPS operations. The skewed order models meeting times: keys arrive
+ * almost in time order, and most lookups go to the busiest tenth of the times.
+ *
+ * Output, one line per phase and then a memory line:
+ *   oc_bench: <phase> ns_per_op N cmp_per_op C
+ *   oc_bench: memory heap_kb H peak_rss_kb R
+ * heap_kb is the heap held by the full container; peak_rss_kb covers the process. */
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "Ordered_container.h"
+
+#define REPEAT_OPS 100000
+#define SKEW_WINDOW 32          /* how far out of time order a skewed key may arrive */
+#define HOT_PERCENT 90          /* share of skewed lookups going to the hot keys */
+#define HOT_FRACTION 10         /* the hot keys are the first 1 / HOT_FRACTION */
+
+enum Phase {INSERT, FIND, APPLY, DELETE, N_PHASES};
+static const char* const phase_names[N_PHASES] = {"insert", "find", "apply", "delete"};
+
+static unsigned long comparisons = 0;
+static unsigned long applied = 0;
+static unsigned long random_state = 1;
+
+static int compare_keys(const void* key_ptr1, const void* key_ptr2);
+static void touch_key(void* key_ptr);
+static unsigned long next_random(void);
+static void shuffle(int* array, int n);
+static void make_order(const char* order, int* keys, int* sequence, int* lookups, int n);
+static double now_ns(void);
+static long heap_bytes(void);
+static long peak_rss_kb(void);
+
+int main(int argc, char* argv[])
+{
+  const char* order;
+  int size;
+  int reps;
+  int rep;
+  int i;
+  int* keys;
+  int* sequence;
+  int* lookups;
+  struct Ordered_container* c_ptr;
+  double start;
+  double elapsed[N_PHASES] = {0., 0., 0., 0.};
+  unsigned long compared[N_PHASES] = {0, 0, 0, 0};
+  long heap_before = 0;
+  long heap_full = 0;
+
+  if (argc < 3 || (size = atoi(argv[2])) <= 0) {
+    fprintf(stderr, "usage: %s random|ascending|descending|skewed size [seed]\n", argv[0]);
+    return 1;
+  }
+  order = argv[1];
+  random_state = (argc > 3) ? strtoul(argv[3], NULL, 10) : 1;
+  reps = (size < REPEAT_OPS) ? (REPEAT_OPS + size - 1) / size : 1;
+
+  keys = malloc(size * sizeof(int));
+  sequence = malloc(size * sizeof(int));
+  lookups = malloc(size * sizeof(int));
+  if (!keys || !sequence || !lookups) {
+    fprintf(stderr, "Out of memory for %d keys\n", size);
+    return 1;
+  }
+  for (i = 0; i < size; ++i) {
+    keys[i] = i;
+  }
+  make_order(order, keys, sequence, lookups, size);
+
+  for (rep = 0; rep < reps; ++rep) {
+    if (rep == 0) {
+      heap_before = heap_bytes();
+    }
+    c_ptr = OC_create_container(compare_keys);
+
+    comparisons = 0;
+    start = now_ns();
+    for (i = 0; i < size; ++i) {
+      OC_insert(c_ptr, &keys[sequence[i]]);
+    }
+    elapsed[INSERT] += now_ns() - start;
+    compared[INSERT] += comparisons;
+
+    if (rep == 0) {
+      heap_full = heap_bytes();
+    }
+
+    comparisons = 0;
+    start = now_ns();
+    for (i = 0; i < size; ++i) {
+      if (!OC_find_item(c_ptr, &keys[lookups[i]])) {
+        fprintf(stderr, "Key %d not found\n", lookups[i]);
+        return 1;
+      }
+    }
+    elapsed[FIND] += now_ns() - start;
+    compared[FIND] += comparisons;
+
+    start = now_ns();
+    OC_apply(c_ptr, touch_key);
+    elapsed[APPLY] += now_ns() - start;
+
+    comparisons = 0;
+    start = now_ns();
+    for (i = 0; i < size; ++i) {
+      OC_delete_item(c_ptr, OC_find_item(c_ptr, &keys[sequence[i]]));
+    }
+    elapsed[DELETE] += now_ns() - start;
+    compared[DELETE] += comparisons;
+
+    OC_destroy_container(c_ptr);
+  }
+
+  if (applied != (unsigned long)size * reps) {
+    fprintf(stderr, "Apply visited %lu items, expected %lu\n", applied,
+            (unsigned long)size * reps);
+    return 1;
+  }
+
+  for (i = 0; i < N_PHASES; ++i) {
+    printf("oc_bench: %s ns_per_op %.1f cmp_per_op %.2f\n", phase_names[i],
+           elapsed[i] / size / reps, (double)compared[i] / size / reps);
+  }
+  printf("oc_bench: memory heap_kb %ld peak_rss_kb %ld\n",
+         (heap_full - heap_before) / 1024, peak_rss_kb());
+
+  free(keys);
+  free(sequence);
+  free(lookups);
+  return 0;
+}
+
+static int compare_keys(const void* key_ptr1, const void* key_ptr2)
+{
+  int key1 = *(const int*)key_ptr1;
+  int key2 = *(const int*)key_ptr2;
+
+  ++comparisons;
+  return (key1 > key2) - (key1 < key2);
+}
+
+static void touch_key(void* key_ptr)
+{
+  applied += *(int*)key_ptr >= 0;
+}
+
+/* xorshift, so that every platform sees the same sequences for a seed */
+static unsigned long next_random(void)
+{
+  random_state ^= (random_state << 13) & 0xffffffffUL;
+  random_state ^= random_state >> 17;
+  random_state ^= (random_state << 5) & 0xffffffffUL;
+  return random_state;
+}
+
+static void shuffle(int* array, int n)
+{
+  int i;
+  int j;
+  int temp;
+
+  for (i = n - 1; i > 0; --i) {
+    j = (int)(next_random() % (unsigned long)(i + 1));
+    temp = array[i];
+    array[i] = array[j];
+    array[j] = temp;
+  }
+}
+
+/* Fill sequence with the insertion and deletion order and lookups with the find order.
+ * A skewed key arrives up to SKEW_WINDOW places late: sort by key plus a random delay
+ * using a counting pass over the delayed positions. */
+static void make_order(const char* order, int* keys, int* sequence, int* lookups, int n)
+{
+  int i;
+  int hot = (n + HOT_FRACTION - 1) / HOT_FRACTION;
+  int* counts;
+  int* slots;
+
+  if (!strcmp(order, "ascending")) {
+    for (i = 0; i < n; ++i) {
+      sequence[i] = keys[i];
+    }
+  } else if (!strcmp(order, "descending")) {
+    for (i = 0; i < n; ++i) {
+      sequence[i] = keys[n - 1 - i];
+    }
+  } else if (!strcmp(order, "random")) {
+    memcpy(sequence, keys, n * sizeof(int));
+    shuffle(sequence, n);
+  } else if (!strcmp(order, "skewed")) {
+    counts = calloc(n + SKEW_WINDOW + 1, sizeof(int));
+    slots = malloc(n * sizeof(int));
+    for (i = 0; i < n; ++i) {
+      slots[i] = i + (int)(next_random() % SKEW_WINDOW);
+      counts[slots[i] + 1]++;
+    }
+    for (i = 1; i <= n + SKEW_WINDOW; ++i) {
+      counts[i] += counts[i - 1];
+    }
+    for (i = 0; i < n; ++i) {
+      sequence[counts[slots[i]]++] = keys[i];
+    }
+    free(counts);
+    free(slots);
+  } else {
+    fprintf(stderr, "Unrecognized order %s\n", order);
+    exit(1);
+  }
+
+  if (strcmp(order, "skewed")) {
+    memcpy(lookups, keys, n * sizeof(int));
+    shuffle(lookups, n);
+    return;
+  }
+  for (i = 0; i < n; ++i) {
+    lookups[i] = (int)(next_random() % 100 < HOT_PERCENT ? next_random() % hot
+                                                         : next_random() % n);
+  }
+}
+
+static double now_ns(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/* Bytes of heap in use, counting blocks malloc placed in their own mappings. */
+static long heap_bytes(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2();
+
+  return (long)(info.uordblks + info.hblkhd);
+#else
+  return 0;
+#endif
+}
+
+static long peak_rss_kb(void)
+{
+  struct rusage usage;
+
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
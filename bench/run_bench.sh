@@ -0,0 +1,49 @@
+#!/bin/bash
+# Build proj4, proj5 and proj6 with optimization and the allocation counter, drive each
+# with the same scenario from make_scenario.sh, and print one row per engine:
+#   ticks/sec     updates per second, setup excluded
+#   allocs/tick   operator new calls per update
+#   peak_rss_kb   peak resident set size of the full run
+#   view_ms/tick  extra time per update with map, health and amounts views open and shown
+#
+# usage: run_bench.sh [agents] [ticks] [seed]
+# Set ENGINES to a subset of "proj4 proj5 proj6" to skip engines.
+
+agents=${1:-600}
+ticks=${2:-200}
+seed=${3:-1}
+engines=${ENGINES:-proj4 proj5 proj6}
+
+source "$(dirname "$0")/common.sh"
+
+# run engine scenario_file: sets elapsed_ns, allocations and peak_rss_kb
+run() {
+  local start=$(now_ns)
+  "$build_dir/$1" < "$2" > /dev/null 2> "$build_dir/$1.err"
+  elapsed_ns=$(( $(now_ns) - start ))
+  local report=($(grep "^bench:" "$build_dir/$1.err"))
+  allocations=${report[2]}
+  peak_rss_kb=${report[6]}
+}
+
+"$bench_dir/make_scenario.sh" "$agents" 0 0 "$seed" > "$build_dir/setup.txt" || exit 1
+"$bench_dir/make_scenario.sh" "$agents" "$ticks" 0 "$seed" > "$build_dir/ticks.txt"
+"$bench_dir/make_scenario.sh" "$agents" "$ticks" 1 "$seed" > "$build_dir/views.txt"
+
+echo "$agents agents, $ticks ticks, seed $seed"
+printf "%-8s %12s %12s %12s %14s\n" engine ticks/sec allocs/tick peak_rss_kb view_ms/tick
+for engine in $engines; do
+  build $engine "$build_dir/$engine" "$bench_dir/alloc_counter.cpp"
+  run $engine "$build_dir/setup.txt"
+  setup_ns=$elapsed_ns; setup_allocations=$allocations
+  run $engine "$build_dir/ticks.txt"
+  ticks_ns=$(( elapsed_ns - setup_ns )); ticks_allocations=$(( allocations - setup_allocations ))
+  ticks_rss_kb=$peak_rss_kb
+  run $engine "$build_dir/views.txt"
+  views_ns=$(( elapsed_ns - setup_ns ))
+  awk -v e=$engine -v t=$ticks -v tn=$ticks_ns -v ta=$ticks_allocations -v rss=$ticks_rss_kb \
+      -v vn=$views_ns 'BEGIN {
+    printf "%-8s %12.1f %12.1f %12d %14.3f\n", e, (tn > 0 ? t / (tn / 1e9) : 0),
+        ta / (t > 0 ? t : 1), rss, (vn - tn) / 1e6 / (t > 0 ? t : 1)
+  }'
+done
@@ -0,0 +1,72 @@
+#!/bin/bash
+# Build oc_bench.c against each proj1 Ordered_container implementation and run every
+# order at sizes 10, 100, ... up to max_size. Prints one row per run:
+#   ins/fnd/del ns    nanoseconds per insert, find, and find plus delete
+#   ins/fnd/del cmp   comparisons per operation
+#   apply ns          nanoseconds per item visited by OC_apply
+#   heap_kb           heap held by the full container
+#   peak_rss_kb       peak resident set size of the run, keys included
+# A size is skipped when the time per operation of the previous size, grown by the same
+# factor as it grew over the size before that, would make the run longer than MAX_SECONDS.
+#
+# usage: run_oc_bench.sh [max_size] [seed]
+# Set BACKENDS (default: every Ordered_container_*.c, e.g. "array list btree"), ORDERS
+# (default "random ascending descending skewed") and MAX_SECONDS (default 30).
+
+max_size=${1:-10000000}
+seed=${2:-1}
+orders=${ORDERS:-random ascending descending skewed}
+max_seconds=${MAX_SECONDS:-30}
+repeat_ops=100000       # REPEAT_OPS in oc_bench.c: smaller sizes are repeated up to this
+
+source "$(dirname "$0")/common.sh"
+
+proj1_dir=$(source_dir proj1)
+if [ -z "$BACKENDS" ]; then
+  BACKENDS=$(cd "$proj1_dir" && ls Ordered_container_*.c | grep -v demo \
+      | sed 's/Ordered_container_\(.*\)\.c/\1/')
+fi
+
+# build_backend backend: builds build/oc_bench_<backend>
+build_backend() {
+  gcc -std=gnu89 -O2 -w -I"$proj1_dir" "$bench_dir/oc_bench.c" \
+      "$proj1_dir/Ordered_container_$1.c" "$proj1_dir/p1_globals.c" "$proj1_dir/Utility.c" \
+      "$proj1_dir/Person.c" -o "$build_dir/oc_bench_$1" || exit 1
+}
+
+# field report phase name: the value following name on the phase's line of the report
+field() {
+  echo "$1" | awk -v p="$2" -v n="$3" '$2 == p { for (i = 3; i < NF; i++) if ($i == n) print $(i + 1) }'
+}
+
+echo "sizes up to $max_size, seed $seed, at most $max_seconds s per run"
+printf "%-7s %-10s %9s %9s %9s %9s %8s %8s %8s %9s %9s %11s\n" backend order size \
+    ins_ns fnd_ns del_ns ins_cmp fnd_cmp del_cmp apply_ns heap_kb peak_rss_kb
+for backend in $BACKENDS; do
+  build_backend $backend
+  for order in $orders; do
+    previous_ns=0
+    elapsed_ns=0
+    skipping=0
+    for (( size = 10; size <= max_size; size *= 10 )); do
+      if [ $skipping -eq 1 ] || [ $elapsed_ns -gt 0 ] && awk -v e=$elapsed_ns -v p=$previous_ns -v n=$size \
+          -v r=$repeat_ops -v m=$max_seconds 'function ops(k) { return k > r ? k : r }
+          BEGIN { t = e / ops(n / 10); g = (p > 0 ? t / (p / ops(n / 100)) : 1)
+                  exit !(t * (g > 1 ? g : 1) * ops(n) > m * 1e9) }'; then
+        skipping=1
+        printf "%-7s %-10s %9d %9s\n" $backend $order $size skipped
+        continue
+      fi
+      start=$(now_ns)
+      report=$("$build_dir/oc_bench_$backend" $order $size $seed) || exit 1
+      previous_ns=$elapsed_ns
+      elapsed_ns=$(( $(now_ns) - start ))
+      printf "%-7s %-10s %9d %9s %9s %9s %8s %8s %8s %9s %9s %11s\n" $backend $order $size \
+          $(field "$report" insert ns_per_op) $(field "$report" find ns_per_op) \
+          $(field "$report" delete ns_per_op) $(field "$report" insert cmp_per_op) \
+          $(field "$report" find cmp_per_op) $(field "$report" delete cmp_per_op) \
+          $(field "$report" apply ns_per_op) $(field "$report" memory heap_kb) \
+          $(field "$report" memory peak_rss_kb)
+    done
+  done
+done
@@ -0,0 +1,740 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "p1_globals.h"
+#include "Ordered_container.h"
+#include "Utility.h"
+
+/* Every node fills a whole number of cache lines. One 64-byte line would hold only
+ * four children, making the tree twice as deep, so a node spans four lines. */
+#define CACHE_LINE_SIZE 64
+#define NODE_CACHE_LINES 4
+#define NODE_SIZE (CACHE_LINE_SIZE * NODE_CACHE_LINES)
+
+/* A leaf spends three pointer-sized words on its parent, next pointer and count; an
+ * interior node spends two on its parent and count, and holds one fewer key than
+ * children. */
+#define LEAF_CAPACITY ((int)((NODE_SIZE - 3 * sizeof(void*)) / sizeof(struct BT_Item)))
+#define INTERIOR_CAPACITY ((int)((NODE_SIZE - sizeof(void*)) / sizeof(void*) / 2))
+#define LEAF_MINIMUM (LEAF_CAPACITY / 2)
+#define INTERIOR_MINIMUM (INTERIOR_CAPACITY / 2)
+
+typedef int (*OC_comp_func)(const void*, const void*);
+
+struct BT_Leaf;
+struct BT_Interior;
+
+/* An item is a cell of a leaf. It records its leaf so that an item can be deleted
+ * without comparing its data, which the caller may already have deallocated. */
+struct BT_Item {
+  void* data_ptr;
+  struct BT_Leaf* leaf;
+};
+
+/* A leaf holds the items in order. The leaves are linked left to right for in-order
+ * traversal. */
+struct BT_Leaf {
+  struct BT_Interior* parent;     /* NULL for the root */
+  struct BT_Leaf* next;           /* leaf holding the following items, or NULL */
+  int count;                      /* number of items in use */
+  struct BT_Item items[LEAF_CAPACITY];
+};
+
+/* An interior node with count children has count - 1 keys. keys[i] is always the data
+ * pointer of the first item under children[i + 1]; every item under children[i]
+ * compares no greater than it. Keeping the keys pointing at items still in the
+ * container means a comparison never reaches data the caller has deallocated. A child
+ * is a leaf or an interior node depending on how far above the leaves the node is. */
+struct BT_Interior {
+  struct BT_Interior* parent;     /* NULL for the root */
+  int count;                      /* number of children in use */
+  void* keys[INTERIOR_CAPACITY - 1];
+  void* children[INTERIOR_CAPACITY];
+};
+
+/* Declaration for Ordered_container. Every leaf is at the same depth, height levels
+ * of interior nodes below the root; when height is 0 the root is a leaf. */
+struct Ordered_container {
+  OC_comp_fp_t comp_func;
+  void* root;
+  int height;
+  int size;
+};
+
+static struct BT_Leaf* create_leaf(void);
+static void destroy_leaf(struct BT_Leaf* leaf);
+static struct BT_Interior* create_interior(void);
+static void destroy_subtree(void* node, int height);
+static struct BT_Leaf* first_leaf(const struct Ordered_container* c_ptr);
+static void set_parent(void* node, int height, struct BT_Interior* parent);
+static struct BT_Interior* get_parent(void* node, int height);
+static int child_index(const struct BT_Interior* parent, const void* child);
+
+/* Return the index of the first of the n keys or items that the key does not come
+ * after - or, if after_equal is set, that the key comes before - or n if there is none. */
+static int search_keys(void* const* keys, int n, const void* key, OC_comp_func comp_func,
+                       int after_equal);
+static int search_items(const struct BT_Item* items, int n, const void* key,
+                        OC_comp_func comp_func, int after_equal);
+
+/* Helper function for searching for an item. Returns the item that compares equal to
+ * 'key' according to 'comp_func', or NULL if there is none. */
+static struct BT_Item* find_item(const struct Ordered_container* c_ptr, const void* key,
+                                 OC_comp_func comp_func);
+
+/* Insert the data pointer into the subtree after any equal items. If the subtree's
+ * root had to split, the new node to its right is returned and the key separating
+ * them is stored in 'separator'; otherwise NULL is returned. */
+static void* insert_into(void* node, int height, void* data_ptr, OC_comp_func comp_func,
+                         void** separator);
+static struct BT_Leaf* insert_into_leaf(struct BT_Leaf* leaf, void* data_ptr,
+                                        OC_comp_func comp_func, void** separator);
+static struct BT_Interior* insert_into_interior(struct BT_Interior* interior, int height,
+                                                int index, void* key, void* child,
+                                                void** separator);
+
+/* The first item of the leaf has changed: point the one key that named the old first
+ * item at the new one. */
+static void replace_separator(struct BT_Leaf* leaf);
+/* If the child is short, take from a sibling that can spare some, or else merge it with
+ * a sibling. Returns non-zero if the parent lost a child to a merge. */
+static int fill_leaf_child(struct BT_Interior* parent, int index);
+static int fill_interior_child(struct BT_Interior* parent, int index, int height);
+/* Remove keys[key_index] and children[key_index + 1] from the interior node. */
+static void remove_from_interior(struct BT_Interior* interior, int key_index);
+
+struct Ordered_container* OC_create_container(OC_comp_fp_t comp_func)
+{
+  struct Ordered_container* c_ptr =
+      safe_malloc(sizeof(struct Ordered_container));
+
+  /* Initialize container variables; the tree starts as one empty leaf. */
+  c_ptr->comp_func = comp_func;
+  c_ptr->root = create_leaf();
+  c_ptr->height = 0;
+  c_ptr->size = 0;
+
+  g_Container_count++;
+
+  return c_ptr;
+}
+
+void OC_destroy_container(struct Ordered_container* c_ptr)
+{
+  destroy_subtree(c_ptr->root, c_ptr->height);
+  g_Container_items_in_use -= c_ptr->size;
+
+  /* After freeing all nodes, free the container. */
+  free(c_ptr);
+
+  assert(g_Container_count > 0);
+  g_Container_count--;
+}
+
+void OC_clear(struct Ordered_container* c_ptr)
+{
+  destroy_subtree(c_ptr->root, c_ptr->height);
+  g_Container_items_in_use -= c_ptr->size;
+
+  /* Restore the single empty leaf. */
+  c_ptr->root = create_leaf();
+  c_ptr->height = 0;
+  c_ptr->size = 0;
+}
+
+int OC_get_size(const struct Ordered_container* c_ptr)
+{
+  return c_ptr->size;
+}
+
+int OC_empty(const struct Ordered_container* c_ptr)
+{
+  return c_ptr->size == 0;
+}
+
+void* OC_get_data_ptr(const void* item_ptr)
+{
+  assert(item_ptr);
+  return ((const struct BT_Item*)item_ptr)->data_ptr;
+}
+
+/* The item is found through its leaf and the leaf's ancestors through their parents,
+ * so nothing is compared. */
+void OC_delete_item(struct Ordered_container* c_ptr, void* item_ptr)
+{
+  struct BT_Item* item = item_ptr;
+  struct BT_Leaf* leaf = item->leaf;
+  struct BT_Interior* parent;
+  void* node;
+  int index = (int)(item - leaf->items);
+  int height;
+  int i;
+
+  assert(index >= 0 && index < leaf->count);
+
+  for (i = index; i < leaf->count - 1; ++i) {
+    leaf->items[i] = leaf->items[i + 1];
+  }
+  leaf->count--;
+  if (index == 0 && leaf->count > 0) {
+    replace_separator(leaf);
+  }
+
+  /* Restore the minimum fill bottom up; only a merge can leave the parent short. */
+  node = leaf;
+  for (height = 0; (parent = get_parent(node, height)) != NULL; ++height) {
+    index = child_index(parent, node);
+    if (!(height == 0 ? fill_leaf_child(parent, index)
+                      : fill_interior_child(parent, index, height))) {
+      break;
+    }
+    node = parent;
+  }
+
+  /* An interior root left with a single child is no longer needed. */
+  if (c_ptr->height > 0 && ((struct BT_Interior*)c_ptr->root)->count == 1) {
+    parent = c_ptr->root;
+    c_ptr->root = parent->children[0];
+    c_ptr->height--;
+    set_parent(c_ptr->root, c_ptr->height, NULL);
+    free(parent);
+  }
+
+  c_ptr->size--;
+  g_Container_items_in_use--;
+}
+
+void OC_insert(struct Ordered_container* c_ptr, void* data_ptr)
+{
+  void* separator;
+  struct BT_Interior* new_root;
+  void* right = insert_into(c_ptr->root, c_ptr->height, data_ptr, c_ptr->comp_func,
+                            &separator);
+
+  /* If the root split, grow the tree by one level. */
+  if (right) {
+    new_root = create_interior();
+    new_root->count = 2;
+    new_root->keys[0] = separator;
+    new_root->children[0] = c_ptr->root;
+    new_root->children[1] = right;
+    set_parent(c_ptr->root, c_ptr->height, new_root);
+    set_parent(right, c_ptr->height, new_root);
+    c_ptr->root = new_root;
+    c_ptr->height++;
+  }
+
+  c_ptr->size++;
+  g_Container_items_in_use++;
+}
+
+void* OC_find_item(const struct Ordered_container* c_ptr, const void* data_ptr)
+{
+  return find_item(c_ptr, data_ptr, c_ptr->comp_func);
+}
+
+void* OC_find_item_arg(const struct Ordered_container* c_ptr,
+                       const void* arg_ptr,
+                       OC_find_item_arg_fp_t fafp)
+{
+  return find_item(c_ptr, arg_ptr, fafp);
+}
+
+void OC_apply(const struct Ordered_container* c_ptr, OC_apply_fp_t afp)
+{
+  struct BT_Leaf* leaf;
+  int i;
+
+  for (leaf = first_leaf(c_ptr); leaf; leaf = leaf->next) {
+    for (i = 0; i < leaf->count; ++i) {
+      afp(leaf->items[i].data_ptr);
+    }
+  }
+}
+
+int OC_apply_if(const struct Ordered_container* c_ptr, OC_apply_if_fp_t afp)
+{
+  struct BT_Leaf* leaf;
+  int i;
+  int return_val;
+
+  for (leaf = first_leaf(c_ptr); leaf; leaf = leaf->next) {
+    for (i = 0; i < leaf->count; ++i) {
+      if ((return_val = afp(leaf->items[i].data_ptr)) != 0) {
+        return return_val;
+      }
+    }
+  }
+
+  return 0;
+}
+
+void OC_apply_arg(const struct Ordered_container* c_ptr,
+                  OC_apply_arg_fp_t afp,
+                  void* arg_ptr)
+{
+  struct BT_Leaf* leaf;
+  int i;
+
+  for (leaf = first_leaf(c_ptr); leaf; leaf = leaf->next) {
+    for (i = 0; i < leaf->count; ++i) {
+      afp(leaf->items[i].data_ptr, arg_ptr);
+    }
+  }
+}
+
+int OC_apply_if_arg(const struct Ordered_container* c_ptr,
+                    OC_apply_if_arg_fp_t afp,
+                    void* arg_ptr)
+{
+  struct BT_Leaf* leaf;
+  int i;
+  int return_val;
+
+  for (leaf = first_leaf(c_ptr); leaf; leaf = leaf->next) {
+    for (i = 0; i < leaf->count; ++i) {
+      if ((return_val = afp(leaf->items[i].data_ptr, arg_ptr)) != 0) {
+        return return_val;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/* The items of a leaf count as allocated for as long as the leaf exists. */
+static struct BT_Leaf* create_leaf(void)
+{
+  struct BT_Leaf* leaf = safe_malloc(sizeof(struct BT_Leaf));
+
+  leaf->parent = NULL;
+  leaf->next = NULL;
+  leaf->count = 0;
+
+  g_Container_items_allocated += LEAF_CAPACITY;
+
+  return leaf;
+}
+
+static void destroy_leaf(struct BT_Leaf* leaf)
+{
+  free(leaf);
+  g_Container_items_allocated -= LEAF_CAPACITY;
+}
+
+static struct BT_Interior* create_interior(void)
+{
+  struct BT_Interior* interior = safe_malloc(sizeof(struct BT_Interior));
+
+  interior->parent = NULL;
+  interior->count = 0;
+
+  return interior;
+}
+
+static void destroy_subtree(void* node, int height)
+{
+  struct BT_Interior* interior;
+  int i;
+
+  if (height == 0) {
+    destroy_leaf(node);
+    return;
+  }
+
+  interior = node;
+  for (i = 0; i < interior->count; ++i) {
+    destroy_subtree(interior->children[i], height - 1);
+  }
+  free(interior);
+}
+
+static struct BT_Leaf* first_leaf(const struct Ordered_container* c_ptr)
+{
+  void* node = c_ptr->root;
+  int level;
+
+  for (level = c_ptr->height; level > 0; --level) {
+    node = ((struct BT_Interior*)node)->children[0];
+  }
+
+  return node;
+}
+
+static void set_parent(void* node, int height, struct BT_Interior* parent)
+{
+  if (height == 0) {
+    ((struct BT_Leaf*)node)->parent = parent;
+  } else {
+    ((struct BT_Interior*)node)->parent = parent;
+  }
+}
+
+static struct BT_Interior* get_parent(void* node, int height)
+{
+  return (height == 0) ? ((struct BT_Leaf*)node)->parent
+                       : ((struct BT_Interior*)node)->parent;
+}
+
+static int child_index(const struct BT_Interior* parent, const void* child)
+{
+  int i;
+
+  for (i = 0; parent->children[i] != child; ++i) {
+    assert(i < parent->count - 1);
+  }
+
+  return i;
+}
+
+static int search_keys(void* const* keys, int n, const void* key, OC_comp_func comp_func,
+                       int after_equal)
+{
+  int low = 0;
+  int high = n;
+  int mid;
+  int result;
+
+  while (low < high) {
+    mid = (low + high) / 2;
+    result = comp_func(key, keys[mid]);
+    if (result > 0 || (after_equal && result == 0)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+static int search_items(const struct BT_Item* items, int n, const void* key,
+                        OC_comp_func comp_func, int after_equal)
+{
+  int low = 0;
+  int high = n;
+  int mid;
+  int result;
+
+  while (low < high) {
+    mid = (low + high) / 2;
+    result = comp_func(key, items[mid].data_ptr);
+    if (result > 0 || (after_equal && result == 0)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+/* Follow the children the key does not come after. The first item the key does not
+ * come after is then either in the leaf reached, or first in the next leaf. */
+static struct BT_Item* find_item(const struct Ordered_container* c_ptr, const void* key,
+                                 OC_comp_func comp_func)
+{
+  void* node = c_ptr->root;
+  struct BT_Interior* interior;
+  struct BT_Leaf* leaf;
+  int level;
+  int index;
+
+  for (level = c_ptr->height; level > 0; --level) {
+    interior = node;
+    node = interior->children[search_keys(interior->keys, interior->count - 1, key,
+                                           comp_func, 0)];
+  }
+
+  leaf = node;
+  index = search_items(leaf->items, leaf->count, key, comp_func, 0);
+  if (index == leaf->count) {
+    leaf = leaf->next;
+    index = 0;
+    if (!leaf) {
+      return NULL;
+    }
+  }
+
+  return (comp_func(key, leaf->items[index].data_ptr) == 0) ? &leaf->items[index] : NULL;
+}
+
+static void* insert_into(void* node, int height, void* data_ptr, OC_comp_func comp_func,
+                         void** separator)
+{
+  struct BT_Interior* interior;
+  int index;
+  void* child_separator;
+  void* right;
+
+  if (height == 0) {
+    return insert_into_leaf(node, data_ptr, comp_func, separator);
+  }
+
+  interior = node;
+  index = search_keys(interior->keys, interior->count - 1, data_ptr, comp_func, 1);
+  right = insert_into(interior->children[index], height - 1, data_ptr, comp_func,
+                      &child_separator);
+  if (!right) {
+    return NULL;
+  }
+
+  /* The child split; its new right sibling goes in just after it. */
+  return insert_into_interior(interior, height, index, child_separator, right, separator);
+}
+
+/* The new item goes after every item equal to it, and every key equals the first item
+ * below it, so an item is never inserted first in any leaf but the leftmost one and
+ * the keys stay valid. */
+static struct BT_Leaf* insert_into_leaf(struct BT_Leaf* leaf, void* data_ptr,
+                                        OC_comp_func comp_func, void** separator)
+{
+  struct BT_Item items[LEAF_CAPACITY + 1];
+  struct BT_Leaf* right;
+  int index = search_items(leaf->items, leaf->count, data_ptr, comp_func, 1);
+  int i;
+  int left_count;
+
+  if (leaf->count < LEAF_CAPACITY) {
+    for (i = leaf->count; i > index; --i) {
+      leaf->items[i] = leaf->items[i - 1];
+    }
+    leaf->items[index].data_ptr = data_ptr;
+    leaf->items[index].leaf = leaf;
+    leaf->count++;
+    return NULL;
+  }
+
+  /* The leaf is full: lay out all the items in order, then give the upper half to a
+   * new leaf to the right. */
+  for (i = 0; i < index; ++i) {
+    items[i] = leaf->items[i];
+  }
+  items[index].data_ptr = data_ptr;
+  for (i = index; i < leaf->count; ++i) {
+    items[i + 1] = leaf->items[i];
+  }
+
+  right = create_leaf();
+  left_count = (LEAF_CAPACITY + 1) / 2;
+  for (i = 0; i < left_count; ++i) {
+    leaf->items[i].data_ptr = items[i].data_ptr;
+    leaf->items[i].leaf = leaf;
+  }
+  for (i = left_count; i < LEAF_CAPACITY + 1; ++i) {
+    right->items[i - left_count].data_ptr = items[i].data_ptr;
+    right->items[i - left_count].leaf = right;
+  }
+  leaf->count = left_count;
+  right->count = LEAF_CAPACITY + 1 - left_count;
+
+  right->next = leaf->next;
+  leaf->next = right;
+
+  *separator = right->items[0].data_ptr;
+  return right;
+}
+
+static struct BT_Interior* insert_into_interior(struct BT_Interior* interior, int height,
+                                                int index, void* key, void* child,
+                                                void** separator)
+{
+  void* keys[INTERIOR_CAPACITY];
+  void* children[INTERIOR_CAPACITY + 1];
+  struct BT_Interior* right;
+  int i;
+  int left_count;
+
+  if (interior->count < INTERIOR_CAPACITY) {
+    for (i = interior->count - 1; i > index; --i) {
+      interior->keys[i] = interior->keys[i - 1];
+      interior->children[i + 1] = interior->children[i];
+    }
+    interior->keys[index] = key;
+    interior->children[index + 1] = child;
+    interior->count++;
+    set_parent(child, height - 1, interior);
+    return NULL;
+  }
+
+  /* The node is full: lay out all the keys and children in order, keep the lower
+   * half, move the upper half to a new node, and pass the middle key up. */
+  for (i = 0; i < INTERIOR_CAPACITY - 1; ++i) {
+    keys[i < index ? i : i + 1] = interior->keys[i];
+  }
+  keys[index] = key;
+  for (i = 0; i < INTERIOR_CAPACITY; ++i) {
+    children[i <= index ? i : i + 1] = interior->children[i];
+  }
+  children[index + 1] = child;
+
+  right = create_interior();
+  left_count = (INTERIOR_CAPACITY + 1) / 2;
+  for (i = 0; i < left_count - 1; ++i) {
+    interior->keys[i] = keys[i];
+  }
+  for (i = 0; i < left_count; ++i) {
+    interior->children[i] = children[i];
+    set_parent(children[i], height - 1, interior);
+  }
+  for (i = left_count; i < INTERIOR_CAPACITY; ++i) {
+    right->keys[i - left_count] = keys[i];
+  }
+  for (i = left_count; i < INTERIOR_CAPACITY + 1; ++i) {
+    right->children[i - left_count] = children[i];
+    set_parent(children[i], height - 1, right);
+  }
+  interior->count = left_count;
+  right->count = INTERIOR_CAPACITY + 1 - left_count;
+
+  *separator = keys[left_count - 1];
+  return right;
+}
+
+/* The key naming the first item of a subtree is in the lowest ancestor the subtree is
+ * not the leftmost child of; the leftmost leaf of the whole tree has no such key. */
+static void replace_separator(struct BT_Leaf* leaf)
+{
+  void* node = leaf;
+  struct BT_Interior* parent;
+  int height;
+  int index;
+
+  for (height = 0; (parent = get_parent(node, height)) != NULL; ++height) {
+    index = child_index(parent, node);
+    if (index > 0) {
+      parent->keys[index - 1] = leaf->items[0].data_ptr;
+      return;
+    }
+    node = parent;
+  }
+}
+
+static int fill_leaf_child(struct BT_Interior* parent, int index)
+{
+  struct BT_Leaf* child = parent->children[index];
+  struct BT_Leaf* left = (index > 0) ? parent->children[index - 1] : NULL;
+  struct BT_Leaf* right = (index < parent->count - 1) ? parent->children[index + 1] : NULL;
+  int i;
+
+  if (child->count >= LEAF_MINIMUM) {
+    return 0;
+  }
+
+  if (left && left->count > LEAF_MINIMUM) {
+    for (i = child->count; i > 0; --i) {
+      child->items[i] = child->items[i - 1];
+    }
+    child->items[0].data_ptr = left->items[--left->count].data_ptr;
+    child->items[0].leaf = child;
+    child->count++;
+    parent->keys[index - 1] = child->items[0].data_ptr;
+    return 0;
+  }
+
+  if (right && right->count > LEAF_MINIMUM) {
+    child->items[child->count].data_ptr = right->items[0].data_ptr;
+    child->items[child->count].leaf = child;
+    child->count++;
+    for (i = 0; i < right->count - 1; ++i) {
+      right->items[i] = right->items[i + 1];
+    }
+    right->count--;
+    parent->keys[index] = right->items[0].data_ptr;
+    return 0;
+  }
+
+  /* Merge the right one of the pair into the left one. */
+  if (!left) {
+    left = child;
+    child = right;
+    index++;
+  }
+  for (i = 0; i < child->count; ++i) {
+    left->items[left->count + i].data_ptr = child->items[i].data_ptr;
+    left->items[left->count + i].leaf = left;
+  }
+  left->count += child->count;
+  left->next = child->next;
+  destroy_leaf(child);
+  remove_from_interior(parent, index - 1);
+  return 1;
+}
+
+/* Children move between interior siblings by rotating through the key between them. */
+static int fill_interior_child(struct BT_Interior* parent, int index, int height)
+{
+  struct BT_Interior* child = parent->children[index];
+  struct BT_Interior* left = (index > 0) ? parent->children[index - 1] : NULL;
+  struct BT_Interior* right = (index < parent->count - 1) ? parent->children[index + 1] : NULL;
+  int i;
+
+  if (child->count >= INTERIOR_MINIMUM) {
+    return 0;
+  }
+
+  if (left && left->count > INTERIOR_MINIMUM) {
+    for (i = child->count - 1; i > 0; --i) {
+      child->keys[i] = child->keys[i - 1];
+    }
+    for (i = child->count; i > 0; --i) {
+      child->children[i] = child->children[i - 1];
+    }
+    child->keys[0] = parent->keys[index - 1];
+    child->children[0] = left->children[left->count - 1];
+    set_parent(child->children[0], height - 1, child);
+    child->count++;
+    parent->keys[index - 1] = left->keys[left->count - 2];
+    left->count--;
+    return 0;
+  }
+
+  if (right && right->count > INTERIOR_MINIMUM) {
+    child->keys[child->count - 1] = parent->keys[index];
+    child->children[child->count] = right->children[0];
+    set_parent(child->children[child->count], height - 1, child);
+    child->count++;
+    parent->keys[index] = right->keys[0];
+    for (i = 0; i < right->count - 2; ++i) {
+      right->keys[i] = right->keys[i + 1];
+    }
+    for (i = 0; i < right->count - 1; ++i) {
+      right->children[i] = right->children[i + 1];
+    }
+    right->count--;
+    return 0;
+  }
+
+  /* Merge the right one of the pair into the left one. */
+  if (!left) {
+    left = child;
+    child = right;
+    index++;
+  }
+  left->keys[left->count - 1] = parent->keys[index - 1];
+  for (i = 0; i < child->count - 1; ++i) {
+    left->keys[left->count + i] = child->keys[i];
+  }
+  for (i = 0; i < child->count; ++i) {
+    left->children[left->count + i] = child->children[i];
+    set_parent(child->children[i], height - 1, left);
+  }
+  left->count += child->count;
+  free(child);
+  remove_from_interior(parent, index - 1);
+  return 1;
+}
+
+static void remove_from_interior(struct BT_Interior* interior, int key_index)
+{
+  int i;
+
+  for (i = key_index; i < interior->count - 2; ++i) {
+    interior->keys[i] = interior->keys[i + 1];
+  }
+  for (i = key_index + 1; i < interior->count - 1; ++i) {
+    interior->children[i] = interior->children[i + 1];
+  }
+  interior->count--;
+}
@@ -6,12 +6,23 @@ make
 diff out.txt normal_out_list.txt 
 ./p1Aexe < normal_in.txt > out.txt 
 diff out.txt normal_out_array.txt 
+./p1Bexe < normal_in.txt > out.txt 
+diff out.txt normal_out_btree.txt 
 ./p1Lexe < errors_in.txt > out.txt 
 diff out.txt errors_out.txt 
 ./p1Aexe < errors_in.txt > out.txt 
 diff out.txt errors_out.txt 
+./p1Bexe < errors_in.txt > out.txt 
+diff out.txt errors_out.txt 
 ./p1Lexe < typeahead_in.txt > out.txt 
 diff out.txt typeahead_out.txt 
 ./p1Aexe < typeahead_in.txt > out.txt 
+diff out.txt typeahead_out.txt 
+./p1Bexe < typeahead_in.txt > out.txt 
 diff out.txt typeahead_out.txt
- 
+./p1Lexe < stress_in.txt > out.txt 
+diff out.txt stress_out.txt 
+./p1Aexe < stress_in.txt > out.txt 
+diff out.txt stress_out.txt 
+./p1Bexe < stress_in.txt > out.txt 
+diff out.txt stress_out.txt
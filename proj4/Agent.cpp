@@ -135,6 +135,10 @@ void Agent::lose_health(int attack_strength)
 {
   health -= attack_strength;
   if (health <= 0) {
+    // Tell the Model the first time, so it knows to remove us once we are disappearing.
+    if (state == ALIVE) {
+      g_Model_ptr->add_dying_agent(this);
+    }
     state = DYING;
     stop_moving();
     cout << get_name() << ": Arrggh!" << endl;
@@ -1,5 +1,6 @@
 #include "Farm.h"
 
+#include "Free_list.h"
 #include "Geometry.h"
 
 #include <iostream>
@@ -7,6 +8,9 @@
 #define INITIAL_FOOD 50.0
 #define FOOD_PRODUCED_PER_UPDATE 2.0
 
+// storage of Farms, with the memory of deleted ones kept for reuse
+Free_list farm_storage(sizeof(Farm));
+
 Farm::Farm(const std::string& in_name, Point in_location)
     : Structure(in_name, in_location), food_available{INITIAL_FOOD}
 {
@@ -18,6 +22,16 @@ Farm::~Farm()
   std::cout << "Farm " << get_name() << " destructed" << std::endl;
 }
 
+void* Farm::operator new(std::size_t size)
+{
+  return farm_storage.allocate(size);
+}
+
+void Farm::operator delete(void* block, std::size_t size)
+{
+  farm_storage.deallocate(block, size);
+}
+
 double Farm::withdraw(double amount_to_get)
 {
   double withdrawl = amount_to_get;
@@ -9,6 +9,8 @@ Food can be withdrawn, but no provision is made for depositing any.
 #include "Sim_object.h"
 #include "Structure.h"
 
+#include <cstddef>
+
 struct Point;
 
 class Farm : public Structure {
@@ -16,6 +18,9 @@ public:
 	Farm (const std::string& in_name, Point in_location);
 	
   ~Farm();
+
+	static void* operator new(std::size_t size);
+	static void operator delete(void* block, std::size_t size);
 		
 	// returns the specified amount, or the remaining amount, whichever is less,
 	// and deducts that amount from the amount on hand
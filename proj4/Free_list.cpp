@@ -0,0 +1,60 @@
+#include "Free_list.h"
+
+#include <new>
+#include <vector>
+
+#define BLOCKS_PER_SLAB 64
+
+Free_list::Free_list(std::size_t block_size_)
+    : block_size{block_size_ < sizeof(Block) ? sizeof(Block) : block_size_},
+      head{nullptr}
+{}
+
+// return the slabs to the heap
+Free_list::~Free_list()
+{
+  for (char* slab : slabs) {
+    ::operator delete(slab);
+  }
+}
+
+// return a block of size bytes, reusing a kept one if possible
+void* Free_list::allocate(std::size_t size)
+{
+  if (size != block_size) {
+    return ::operator new(size);
+  }
+  if (!head) {
+    add_slab();
+  }
+  Block* block = head;
+  head = head->next;
+  return block;
+}
+
+// keep the block of size bytes for reuse
+void Free_list::deallocate(void* block, std::size_t size)
+{
+  if (!block) {
+    return;
+  }
+  if (size != block_size) {
+    ::operator delete(block);
+    return;
+  }
+  Block* kept = static_cast<Block*>(block);
+  kept->next = head;
+  head = kept;
+}
+
+// get a new slab and keep all of its blocks, the first one at the head
+void Free_list::add_slab()
+{
+  char* slab = static_cast<char*>(::operator new(block_size * BLOCKS_PER_SLAB));
+  slabs.push_back(slab);
+  for (int i = BLOCKS_PER_SLAB - 1; i >= 0; --i) {
+    Block* block = reinterpret_cast<Block*>(slab + i * block_size);
+    block->next = head;
+    head = block;
+  }
+}
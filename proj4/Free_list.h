@@ -0,0 +1,48 @@
+#ifndef FREE_LIST_H
+#define FREE_LIST_H
+
+#include <cstddef>
+#include <vector>
+
+/*
+A Free_list hands out blocks for objects of one class, carved from slabs that each hold
+several blocks, and keeps the memory of deleted objects for the next ones created
+instead of going back to the heap each time. Slabs are never moved or given back until
+the Free_list is destroyed, so an object stays where it was created. A class uses one
+through its own operator new and operator delete. Blocks of any other size, such as for
+a class derived from it, come from the heap as usual.
+*/
+
+class Free_list {
+public:
+	// blocks will be block_size_ bytes
+	Free_list(std::size_t block_size_);
+	// return the slabs to the heap
+	~Free_list();
+
+	// return a block of size bytes, reusing a kept one if possible
+	void* allocate(std::size_t size);
+	// keep the block of size bytes for reuse
+	void deallocate(void* block, std::size_t size);
+
+private:
+  // a kept block holds a link to the next one
+  struct Block {
+    Block* next;
+  };
+  
+  std::size_t block_size;
+  Block* head;
+  std::vector<char *> slabs;
+  
+  // get a new slab and keep all of its blocks
+  void add_slab();
+
+	// disallow copy/move construction or assignment
+	Free_list(const Free_list&) = delete;
+	Free_list& operator= (const Free_list&)  = delete;
+	Free_list(Free_list&&) = delete;
+	Free_list& operator= (Free_list&&) = delete;
+};
+
+#endif
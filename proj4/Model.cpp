@@ -14,13 +14,11 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
-using std::map; using std::string; using std::set;
+using std::map; using std::string; using std::set; using std::vector;
 using namespace std::placeholders;
 
-using Sim_object_c = map<string, Sim_object *>;
-using Agent_c = map<string, Agent *>;
-using Structure_c = map<string, Structure *>;
 using View_c = set<View *>;
 
 /* Here define g_Model_ptr */
@@ -44,9 +42,9 @@ Model::Model()
 
 Model::~Model()
 {
-  std::for_each(all_objects.begin(), all_objects.end(), [] (Sim_object_c::value_type pair) {
-      delete pair.second;
-  });
+  for (auto& pair : objects) {
+    delete pair.second.object;
+  }
 }
 
 
@@ -55,8 +53,8 @@ Model::~Model()
 bool Model::is_name_in_use(const std::string& name) const
 {
   string prefix = name.substr(0, UNIQUE_STRING_PREFIX_SIZE);
-  Sim_object_c::const_iterator it = all_objects.lower_bound(prefix);
-  if (it != all_objects.end() &&
+  auto it = objects.lower_bound(prefix);
+  if (it != objects.end() &&
       it->first.substr(0, UNIQUE_STRING_PREFIX_SIZE) == prefix) {
     return true;
   } else {
@@ -66,13 +64,13 @@ bool Model::is_name_in_use(const std::string& name) const
 
 bool Model::is_structure_present(const std::string& name) const
 {
-  return structures.find(name) != structures.end();
+  auto it = objects.find(name);
+  return it != objects.end() && it->second.kind == Object_kind::STRUCTURE;
 }
 
 void Model::add_structure_helper(Structure *structure)
 {
-  all_objects.insert(std::make_pair(structure->get_name(), structure));
-  structures.insert(std::make_pair(structure->get_name(), structure));
+  objects.insert({structure->get_name(), Object_entry{structure, Object_kind::STRUCTURE}});
 }
 
 // add a new structure; assumes none with the same name
@@ -85,23 +83,23 @@ void Model::add_structure(Structure* structure)
 // will throw Error("Structure not found!") if no structure of that name
 Structure* Model::get_structure_ptr(const std::string& name) const
 {
-  Structure_c::const_iterator it = structures.find(name);
-  if (it == structures.end()) {
+  auto it = objects.find(name);
+  if (it == objects.end() || it->second.kind != Object_kind::STRUCTURE) {
     throw Error{"Structure not found!"};
   }
-  return it->second;
+  return static_cast<Structure*>(it->second.object);
 }
 
 // is there an agent with this name?
 bool Model::is_agent_present(const std::string& name) const
 {
-  return agents.find(name) != agents.end();
+  auto it = objects.find(name);
+  return it != objects.end() && it->second.kind == Object_kind::AGENT;
 }
 
 void Model::add_agent_helper(Agent *agent)
 {
-  all_objects.insert(std::make_pair(agent->get_name(), agent));
-  agents.insert(std::make_pair(agent->get_name(), agent));
+  objects.insert({agent->get_name(), Object_entry{agent, Object_kind::AGENT}});
 }
 
 // add a new agent; assumes none with the same name
@@ -114,39 +112,47 @@ void Model::add_agent(Agent* agent)
 // will throw Error("Agent not found!") if no agent of that name
 Agent* Model::get_agent_ptr(const std::string& name) const
 {
-  Agent_c::const_iterator it = agents.find(name);
-  if (it == agents.end()) {
+  auto it = objects.find(name);
+  if (it == objects.end() || it->second.kind != Object_kind::AGENT) {
     throw Error{"Agent not found!"};
   }
-  return it->second;
+  return static_cast<Agent*>(it->second.object);
+}
+
+// an agent has started dying; it is removed once it is disappearing
+void Model::add_dying_agent(Agent* agent)
+{
+  dying_agents.push_back(agent);
 }
 
 // tell all objects to describe themselves to the console
 void Model::describe() const
 {
-  std::for_each(all_objects.begin(), all_objects.end(), [] (Sim_object_c::value_type pair) {
-      pair.second->describe();
-  });
+  for (auto& pair : objects) {
+    pair.second.object->describe();
+  }
 }
 
 // increment the time, and tell all objects to update themselves
 void Model::update()
 {
   ++time;
-  std::for_each(all_objects.begin(), all_objects.end(), [] (Sim_object_c::value_type pair) {
-      pair.second->update();
-  });
-  
-  // Delete all disappearing agents and remove them from both containers.
-  for (Agent_c::iterator it = agents.begin(); it != agents.end(); /* empty */) {
-    if (it->second->is_disappearing()) {
-      all_objects.erase(it->second->get_name());
-      delete it->second;
-      agents.erase(it++);
-    } else {
-      ++it;
-    }
+  for (auto& pair : objects) {
+    pair.second.object->update();
   }
+  
+  // Only dying agents can be disappearing. Delete those that are, in name order,
+  // and remove them from the table.
+  vector<Agent *>::iterator disappearing = std::partition(dying_agents.begin(), dying_agents.end(),
+      [] (Agent* agent) { return !agent->is_disappearing(); });
+  std::sort(disappearing, dying_agents.end(), [] (Agent* a, Agent* b) {
+      return a->get_name() < b->get_name();
+  });
+  std::for_each(disappearing, dying_agents.end(), [this] (Agent* agent) {
+      objects.erase(agent->get_name());
+      delete agent;
+  });
+  dying_agents.erase(disappearing, dying_agents.end());
 }
 
 // Attaching a View adds it to the container and causes it to be updated
@@ -154,9 +160,9 @@ void Model::update()
 void Model::attach(View* view)
 {
   views.insert(view);
-  std::for_each(all_objects.begin(), all_objects.end(), [] (Sim_object_c::value_type pair) {
-    pair.second->broadcast_current_state();
-  });
+  for (auto& pair : objects) {
+    pair.second.object->broadcast_current_state();
+  }
 }
 
 // Detach the View by discarding the supplied pointer from the container of Views
@@ -18,6 +18,7 @@ Notice how only the Standard Library headers need to be included - reduced coupl
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 /* Here provide the appropriate declarations for a global variable named g_Model_ptr of type Model* - follow the Header File Guidelines. */
 // TODO(wjbillin): Is this appropriate to forward declare the class?
@@ -59,6 +60,8 @@ public:
 	void add_agent(Agent*);
 	// will throw Error("Agent not found!") if no agent of that name
 	Agent* get_agent_ptr(const std::string& name) const;
+	// an agent has started dying; it is removed once it is disappearing
+	void add_dying_agent(Agent*);
 	
 	// tell all objects to describe themselves to the console
 	void describe() const;
@@ -78,11 +81,18 @@ public:
 	void notify_gone(const std::string& name);
 	
 private:
+  // every object is in one table, in name order, tagged with what kind of object it is
+  enum class Object_kind {AGENT, STRUCTURE};
+  struct Object_entry {
+    Sim_object* object;
+    Object_kind kind;
+  };
+  
   int time {0};
-  std::map<std::string, Sim_object *> all_objects;
-  std::map<std::string, Agent *> agents;
-  std::map<std::string, Structure *> structures;
+  std::map<std::string, Object_entry> objects;
   std::set<View *> views;
+  // agents that have started dying, the only ones update checks for removal
+  std::vector<Agent *> dying_agents;
 
 	// disallow copy/move construction or assignment
 	Model(const Model&) = delete;
@@ -1,6 +1,7 @@
 #include "Peasant.h"
 
 #include "Agent.h"
+#include "Free_list.h"
 #include "Geometry.h"
 #include "Moving_object.h"
 #include "Sim_object.h"
@@ -14,6 +15,9 @@
 
 using std::cout; using std::endl;
 
+// storage of deleted Peasants, for reuse
+Free_list peasant_storage(sizeof(Peasant));
+
 Peasant::Peasant(const std::string& in_name, Point in_location)
     : Agent(in_name, in_location),
       food_in_hand{INITIAL_CARRYING_FOOD},
@@ -29,6 +33,16 @@ Peasant::~Peasant()
   cout << "Peasant " << get_name() << " destructed" << endl;
 }
 
+void* Peasant::operator new(std::size_t size)
+{
+  return peasant_storage.allocate(size);
+}
+
+void Peasant::operator delete(void* block, std::size_t size)
+{
+  peasant_storage.deallocate(block, size);
+}
+
 // implement Peasant behavior
 void Peasant::update()
 {
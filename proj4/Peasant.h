@@ -13,6 +13,8 @@ If commanded to move_to somewhere, it stops working, and goes there.
 #include "Moving_object.h"
 #include "Sim_object.h"
 
+#include <cstddef>
+
 class Structure;
 struct Point;
 
@@ -23,6 +25,9 @@ public:
 
 	~Peasant();
 
+	static void* operator new(std::size_t size);
+	static void operator delete(void* block, std::size_t size);
+
 	// implement Peasant behavior
 	void update() override;
 	
@@ -1,6 +1,7 @@
 #include "Soldier.h"
 
 #include "Agent.h"
+#include "Free_list.h"
 #include "Geometry.h"
 #include "Moving_object.h"
 #include "Sim_object.h"
@@ -13,6 +14,9 @@
 
 using std::cout; using std::endl;
 
+// storage of deleted Soldiers, for reuse
+Free_list soldier_storage(sizeof(Soldier));
+
 // *** define as specified
 Soldier::Soldier(const std::string& name_, Point location_)
     : Agent(name_, location_),
@@ -29,6 +33,16 @@ Soldier::~Soldier()
   cout << "Soldier " << get_name() << " destructed" << endl;
 }
 
+void* Soldier::operator new(std::size_t size)
+{
+  return soldier_storage.allocate(size);
+}
+
+void Soldier::operator delete(void* block, std::size_t size)
+{
+  soldier_storage.deallocate(block, size);
+}
+
 // update implements Soldier behavior
 void Soldier::update()
 {
@@ -10,6 +10,8 @@ start attacking its attacker.
 
 #include "Agent.h"
 
+#include <cstddef>
+
 struct Point;
 
 class Soldier : public Agent {
@@ -18,6 +20,9 @@ public:
 	// *** define as specified
 	Soldier(const std::string& name_, Point location_);
 	~Soldier();
+
+	static void* operator new(std::size_t size);
+	static void operator delete(void* block, std::size_t size);
 	
 	// update implements Soldier behavior
 	void update() override;
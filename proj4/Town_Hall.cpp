@@ -1,5 +1,6 @@
 #include "Town_Hall.h"
 
+#include "Free_list.h"
 #include "Geometry.h"
 
 #include <iostream>
@@ -8,6 +9,9 @@
 #define TAX_RATE 0.1
 #define MINIMUM_FOOD_AMOUNT 1.0
 
+// storage of Town_Halls, with the memory of deleted ones kept for reuse
+Free_list town_hall_storage(sizeof(Town_Hall));
+
 Town_Hall::Town_Hall(const std::string& in_name, Point in_location)
     : Structure(in_name, in_location), total_food{0}
 {
@@ -19,6 +23,16 @@ Town_Hall::~Town_Hall()
   std::cout << "Town_Hall " << get_name() << " destructed" << std::endl;
 }
 
+void* Town_Hall::operator new(std::size_t size)
+{
+  return town_hall_storage.allocate(size);
+}
+
+void Town_Hall::operator delete(void* block, std::size_t size)
+{
+  town_hall_storage.deallocate(block, size);
+}
+
 void Town_Hall::deposit(double deposit_amount)
 {
   total_food += deposit_amount;
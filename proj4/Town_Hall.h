@@ -9,6 +9,8 @@ but does no updating.
 #include "Sim_object.h"
 #include "Structure.h"
 
+#include <cstddef>
+
 #include <string>
 
 class Town_Hall : public Structure {
@@ -17,6 +19,9 @@ public:
 	
   // TODO(wjbillin): Should this be virtual, or override?
 	~Town_Hall();
+
+	static void* operator new(std::size_t size);
+	static void operator delete(void* block, std::size_t size);
 	
 	// deposit adds in the supplied amount
 	void deposit(double deposit_amount) override;
@@ -56,10 +56,10 @@ void Agent::stop()
 }
 
 // Tell this Agent to accept a hit from an attack of a specified strength
-// The attacking Agent identifies itself with its this pointer.
+// The attacking Agent identifies itself with *this.
 // A derived class can override this function.
 // The function lose_health is called to handle the effect of the attack.
-void Agent::take_hit(int attack_strength, shared_ptr<Agent>attacker_ptr)
+void Agent::take_hit(int attack_strength, Agent& attacker)
 {
   lose_health(attack_strength);
 }
@@ -110,7 +110,7 @@ void Agent::start_working(shared_ptr<Structure>, shared_ptr<Structure>)
 }
 
 // Throws exception that an Agent cannot attack.
-void Agent::start_attacking(shared_ptr<Agent>)
+void Agent::start_attacking(const shared_ptr<Agent>&)
 {
   throw Error{ get_name() + ": Sorry, I can't attack!" };
 }
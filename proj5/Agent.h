@@ -42,10 +42,10 @@ public:
 	virtual void stop();
 
 	// Tell this Agent to accept a hit from an attack of a specified strength
-	// The attacking Agent identifies itself with its this pointer.
+	// The attacking Agent identifies itself with *this.
 	// A derived class can override this function.
 	// The function lose_health is called to handle the effect of the attack.
-	virtual void take_hit(int attack_strength, std::shared_ptr<Agent> attacker_ptr);
+	virtual void take_hit(int attack_strength, Agent& attacker);
 	
 	// update the moving state and Agent state of this object.
 	void update() override;
@@ -61,7 +61,7 @@ public:
 	virtual void start_working(std::shared_ptr<Structure>, std::shared_ptr<Structure>);
 
 	// Throws exception that an Agent cannot attack.
-	virtual void start_attacking(std::shared_ptr<Agent>);
+	virtual void start_attacking(const std::shared_ptr<Agent>&);
 
 protected:
 	// calculate loss of health due to hit.
@@ -39,6 +39,12 @@ Controller::Controller()
   map_view_fp_map.insert(std::make_pair("zoom", &Controller::view_set_zoom));
   map_view_fp_map.insert(std::make_pair("pan", &Controller::view_set_pan));
   
+  attribute_view_fp_map.insert(std::make_pair("lowest", &Controller::view_lowest));
+  attribute_view_fp_map.insert(std::make_pair("highest", &Controller::view_highest));
+  attribute_view_fp_map.insert(std::make_pair("above", &Controller::view_above));
+  attribute_view_fp_map.insert(std::make_pair("below", &Controller::view_below));
+  attribute_view_fp_map.insert(std::make_pair("summary", &Controller::view_summary));
+  
   program_fp_map.insert(std::make_pair("status", &Controller::status));
   program_fp_map.insert(std::make_pair("go", &Controller::update_all_and_go));
   program_fp_map.insert(std::make_pair("build", &Controller::build));
@@ -68,6 +74,7 @@ void Controller::run()
     auto program_fp_it = program_fp_map.find(word);
     auto map_view_fp_it = map_view_fp_map.find(word);
     auto view_mgmt_fp_it = view_mgmt_fp_map.find(word);
+    auto attribute_view_it = open_attribute_views.find(word);
 
     if (Model::getInstance().is_agent_present(word)) {
       shared_ptr<Agent> agent = Model::getInstance().get_agent_ptr(word);
@@ -85,6 +92,15 @@ void Controller::run()
       
       // WOW, this is ugly.
       (this->*(it->second))(agent);
+    } else if (attribute_view_it != open_attribute_views.end()) {
+      string command;
+      cin >> command;
+      auto it = attribute_view_fp_map.find(command);
+      if (it == attribute_view_fp_map.end()) {
+        throw Error{"Unrecognized command!"};
+      }
+      
+      (this->*(it->second))(attribute_view_it->second);
     } else if (program_fp_it != program_fp_map.end()) {
       (this->*(program_fp_it->second))();
     } else if (map_view_fp_it != map_view_fp_map.end()) {
@@ -164,6 +180,36 @@ void Controller::view_set_pan(shared_ptr<MapView> map_view)
   map_view->set_origin(read_point());
 }
 
+// Attribute View commands
+void Controller::view_lowest(shared_ptr<AttributeView> attribute_view)
+{
+  int count = read_int();
+  attribute_view->draw_lowest(count);
+}
+
+void Controller::view_highest(shared_ptr<AttributeView> attribute_view)
+{
+  int count = read_int();
+  attribute_view->draw_highest(count);
+}
+
+void Controller::view_above(shared_ptr<AttributeView> attribute_view)
+{
+  double threshold = read_double();
+  attribute_view->draw_above(threshold);
+}
+
+void Controller::view_below(shared_ptr<AttributeView> attribute_view)
+{
+  double threshold = read_double();
+  attribute_view->draw_below(threshold);
+}
+
+void Controller::view_summary(shared_ptr<AttributeView> attribute_view)
+{
+  attribute_view->draw_summary();
+}
+
 // Whole program commands
 void Controller::status()
 {
@@ -209,14 +255,14 @@ void Controller::open_view(const std::string &name)
   // Check to make sure view type is valid. It can be a type of map or a sim_object name.
   shared_ptr<View> view_to_add;
   if (name == "map") {
-    open_map_view_ptr.reset(new MapView("map"));
+    open_map_view_ptr.reset(new MapView("map", get_location_store()));
     view_to_add = open_map_view_ptr;
   } else if (name == "health") {
-    view_to_add.reset(new HealthView("health"));
+    view_to_add = open_attribute_views[name] = std::make_shared<HealthView>(name);
   } else if (name == "amounts") {
-    view_to_add.reset(new AmountView("amounts"));
+    view_to_add = open_attribute_views[name] = std::make_shared<AmountView>(name);
   } else if (Model::getInstance().is_name_in_use(name)) {
-    view_to_add.reset(new LocalView(name));
+    view_to_add.reset(new LocalView(name, get_location_store()));
   } else {
     throw Error{"No object of that name!"};
   }
@@ -226,6 +272,17 @@ void Controller::open_view(const std::string &name)
   open_views.push_back(view_to_add);
 }
 
+// A new store starts empty; attaching the view then fills it with every object.
+shared_ptr<LocationStore> Controller::get_location_store()
+{
+  shared_ptr<LocationStore> store = location_store.lock();
+  if (!store) {
+    store = std::make_shared<LocationStore>();
+    location_store = store;
+  }
+  return store;
+}
+
 void Controller::close_view(const std::string &name)
 {
   // Find the view.
@@ -244,6 +301,7 @@ void Controller::close_view(const std::string &name)
   if (open_views[index]->get_name() == "map") {
     open_map_view_ptr.reset();
   }
+  open_attribute_views.erase(name);
   
   // Remove from containers.
   Model::getInstance().detach(open_views[index]);
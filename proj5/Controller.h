@@ -11,6 +11,8 @@ with the user.
 class Agent;
 class View;
 class MapView;
+class AttributeView;
+class LocationStore;
 
 class Controller {
 public:	
@@ -22,11 +24,13 @@ public:
 private:
   using agent_command_fp = void (Controller::*)(std::shared_ptr<Agent>);
   using map_view_command_fp = void (Controller::*)(std::shared_ptr<MapView>);
+  using attribute_view_command_fp = void (Controller::*)(std::shared_ptr<AttributeView>);
   using program_command_fp = void (Controller::*)();
   using view_mgmt_command_fp = void (Controller::*)(const std::string&);
   
   std::map<std::string, agent_command_fp> agent_fp_map;
   std::map<std::string, map_view_command_fp> map_view_fp_map;
+  std::map<std::string, attribute_view_command_fp> attribute_view_fp_map;
   std::map<std::string, program_command_fp> program_fp_map;
   std::map<std::string, view_mgmt_command_fp> view_mgmt_fp_map;
   
@@ -38,12 +42,27 @@ private:
   // Map View to call defaults, scale, etc...
   std::shared_ptr<MapView> open_map_view_ptr;
   
+  // Positions shared by the open map and local views; it goes away with the last of them.
+  std::weak_ptr<LocationStore> location_store;
+  
+  std::shared_ptr<LocationStore> get_location_store();
+  
+  // The open health and amounts views, by name, so they can be queried.
+  std::map<std::string, std::shared_ptr<AttributeView>> open_attribute_views;
+  
   // Map View commands.
   void view_reset_defaults(std::shared_ptr<MapView>);
   void view_set_size(std::shared_ptr<MapView>);
   void view_set_zoom(std::shared_ptr<MapView>);
   void view_set_pan(std::shared_ptr<MapView>);
   
+  // Attribute View commands.
+  void view_lowest(std::shared_ptr<AttributeView>);
+  void view_highest(std::shared_ptr<AttributeView>);
+  void view_above(std::shared_ptr<AttributeView>);
+  void view_below(std::shared_ptr<AttributeView>);
+  void view_summary(std::shared_ptr<AttributeView>);
+  
   // View Management Commands.
   void open_view(const std::string& name);
   void close_view(const std::string& name);
@@ -0,0 +1,157 @@
+#include "Kd_tree.h"
+
+#include "Geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using std::vector;
+using std::min; using std::max;
+
+// the most points a leaf holds
+#define LEAF_SIZE 8
+// more than the depth of any tree, which halves the points at each level
+#define MAX_PENDING 128
+
+// build the tree over the points; each point is numbered by its position
+void Kd_tree::build(const vector<Point>& points_)
+{
+  points = points_;
+  nodes.clear();
+  order.resize(points.size());
+  leaf_of.resize(points.size());
+  for (int i = 0; i < int(order.size()); ++i) {
+    order[i] = i;
+  }
+  if (!points.empty()) {
+    nodes.reserve(2 * points.size() / LEAF_SIZE + 1);
+    build_node(-1, 0, int(points.size()));
+  }
+}
+
+// build the node for order[begin, end) and return its index
+int Kd_tree::build_node(int parent, int begin, int end)
+{
+  Node node;
+  node.min_x = node.max_x = points[order[begin]].x;
+  node.min_y = node.max_y = points[order[begin]].y;
+  for (int i = begin + 1; i < end; ++i) {
+    const Point& p = points[order[i]];
+    node.min_x = min(node.min_x, p.x);
+    node.max_x = max(node.max_x, p.x);
+    node.min_y = min(node.min_y, p.y);
+    node.max_y = max(node.max_y, p.y);
+  }
+  node.parent = parent;
+  node.left = node.right = -1;
+  node.begin = begin;
+  node.end = end;
+  int index = int(nodes.size());
+  nodes.push_back(node);
+  
+  if (end - begin <= LEAF_SIZE) {
+    for (int i = begin; i < end; ++i) {
+      leaf_of[order[i]] = index;
+    }
+    return index;
+  }
+  
+  // Split across the longer side at the median.
+  bool split_x = node.max_x - node.min_x >= node.max_y - node.min_y;
+  int middle = begin + (end - begin) / 2;
+  std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                   [this, split_x] (int a, int b) {
+                     return split_x ? points[a].x < points[b].x : points[a].y < points[b].y;
+                   });
+  int left = build_node(index, begin, middle);
+  int right = build_node(index, middle, end);
+  nodes[index].left = left;
+  nodes[index].right = right;
+  return index;
+}
+
+// move the numbered point, growing the rectangles above it until one already holds it
+void Kd_tree::move(int number, Point location)
+{
+  points[number] = location;
+  for (int index = leaf_of[number]; index != -1; index = nodes[index].parent) {
+    Node& node = nodes[index];
+    if (location.x >= node.min_x && location.x <= node.max_x &&
+        location.y >= node.min_y && location.y <= node.max_y) {
+      break;
+    }
+    node.min_x = min(node.min_x, location.x);
+    node.max_x = max(node.max_x, location.x);
+    node.min_y = min(node.min_y, location.y);
+    node.max_y = max(node.max_y, location.y);
+  }
+}
+
+// Computed the way cartesian_distance is, so it is never more than the distance
+// it gives to any point in the rectangle.
+double Kd_tree::lower_bound(const Node& node, Point location) const
+{
+  double xd = 0.0, yd = 0.0;
+  if (location.x < node.min_x) {
+    xd = location.x - node.min_x;
+  } else if (location.x > node.max_x) {
+    xd = location.x - node.max_x;
+  }
+  if (location.y < node.min_y) {
+    yd = location.y - node.min_y;
+  } else if (location.y > node.max_y) {
+    yd = location.y - node.max_y;
+  }
+  return sqrt(xd * xd + yd * yd);
+}
+
+// Return the number of the point nearest to location other than exclude. A node is
+// only skipped if it is strictly farther than the best so far, since a point in it
+// at the same distance might still win by number.
+int Kd_tree::nearest(Point location, int exclude) const
+{
+  int best = -1;
+  double best_distance = 0.0;
+  if (nodes.empty()) {
+    return best;
+  }
+  
+  int pending[MAX_PENDING];
+  int pending_count = 0;
+  pending[pending_count++] = 0;
+  while (pending_count) {
+    const Node& node = nodes[pending[--pending_count]];
+    if (best != -1 && lower_bound(node, location) > best_distance) {
+      continue;
+    }
+    
+    if (node.left == -1) {
+      for (int i = node.begin; i < node.end; ++i) {
+        int number = order[i];
+        if (number == exclude) {
+          continue;
+        }
+        double distance = cartesian_distance(points[number], location);
+        if (best == -1 || distance < best_distance ||
+            (distance == best_distance && number < best)) {
+          best = number;
+          best_distance = distance;
+        }
+      }
+      continue;
+    }
+    
+    // Push the farther child first, so the nearer one is searched first.
+    double left_distance = lower_bound(nodes[node.left], location);
+    double right_distance = lower_bound(nodes[node.right], location);
+    if (left_distance <= right_distance) {
+      pending[pending_count++] = node.right;
+      pending[pending_count++] = node.left;
+    } else {
+      pending[pending_count++] = node.left;
+      pending[pending_count++] = node.right;
+    }
+  }
+  return best;
+}
@@ -0,0 +1,58 @@
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include "Geometry.h"
+
+#include <vector>
+
+/*
+A Kd_tree answers nearest point queries over a numbered set of points without
+looking at all of them. Each node covers a rectangle holding its points, and is
+split across the longer side at the median; a search visits the nearer child
+first and skips any node whose rectangle is farther than the best point so far.
+
+A point can be moved without rebuilding the tree. The rectangles on its way up are
+grown to take in the new location, so queries stay exact, but they get slower as
+the rectangles loosen until the tree is built again.
+*/
+
+class Kd_tree {
+public:
+	// build the tree over the points; each point is numbered by its position
+	void build(const std::vector<Point>& points_);
+	
+	// the number of points in the tree
+	int size() const { return int(points.size()); }
+	
+	// move the numbered point to a new location
+	void move(int number, Point location);
+	
+	// Return the number of the point nearest to location, other than the point
+	// numbered exclude, or -1 if there is no other point. Distances are measured
+	// with cartesian_distance, and of equally near points the lowest numbered wins.
+	int nearest(Point location, int exclude = -1) const;
+	
+private:
+  // a leaf holds the points in order[begin, end); an inner node has two children
+  struct Node {
+    double min_x, min_y, max_x, max_y;
+    int parent;
+    int left, right;
+    int begin, end;
+  };
+  
+  // build the node for order[begin, end) and return its index
+  int build_node(int parent, int begin, int end);
+  
+  // the least distance from location to anywhere in the node's rectangle
+  double lower_bound(const Node& node, Point location) const;
+  
+  std::vector<Point> points;
+  std::vector<Node> nodes;
+  // point numbers, grouped by leaf
+  std::vector<int> order;
+  // the leaf each point is in
+  std::vector<int> leaf_of;
+};
+
+#endif
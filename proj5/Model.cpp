@@ -3,6 +3,7 @@
 #include "Agent.h"
 #include "Agent_factory.h"
 #include "Geometry.h"
+#include "Kd_tree.h"
 #include "Sim_object.h"
 #include "Structure.h"
 #include "Structure_factory.h"
@@ -14,8 +15,9 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
-using std::map; using std::string; using std::set;
+using std::map; using std::string; using std::set; using std::vector;
 using std::shared_ptr;
 using namespace std::placeholders;
 
@@ -24,33 +26,14 @@ using Agent_c = map<string, shared_ptr<Agent>>;
 using Structure_c = map<string, shared_ptr<Structure>>;
 using View_c = set<shared_ptr<View>>;
 
-// Returns a boolean indicating whether or not s1 is closer to origin than s2. We deal
-// with self comparison (i.e. one of s1 or s2 is actually the origin object), by pushing
-// origin to the end of the list.
-bool sim_object_min_distance_comparator(const shared_ptr<Sim_object> origin,
-                                        const shared_ptr<Sim_object> s1,
-                                        const shared_ptr<Sim_object> s2)
-{
-  // If s1 and origin are the same object, s2 should always come first.
-  if (s1 == origin) {
-    return false;
-  }
-  
-  // Similarly, if s2 and origin are the same object, s1 should always come first.
-  if (s2 == origin) {
-    return true;
-  }
-  
-  return cartesian_distance(s1->get_location(), origin->get_location()) <
-         cartesian_distance(s2->get_location(), origin->get_location());
-}
-
 Model& Model::getInstance() {
   static Model instance;
   return instance;
 }
 
 Model::Model()
+    : agent_tree{new Kd_tree},
+      structure_tree{new Kd_tree}
 {
 	add_structure_helper(create_structure("Rivendale", "Farm", Point(10., 10.)));
 	add_structure_helper(create_structure("Sunnybrook", "Farm", Point(0., 30.)));
@@ -64,6 +47,10 @@ Model::Model()
   add_agent_helper(create_agent("Iriel", "Archer", Point(20., 38.)));
 }
 
+// Explicit destructor, Kd_tree is complete here.
+Model::~Model()
+{}
+
 // is name already in use for either agent or structure?
   // either the identical name, or identical in first two characters counts as in-use
 bool Model::is_name_in_use(const std::string& name) const
@@ -87,6 +74,7 @@ void Model::add_structure_helper(shared_ptr<Structure> structure)
 {
   all_objects.insert(std::make_pair(structure->get_name(), structure));
   structures.insert(std::make_pair(structure->get_name(), structure));
+  structures_changed = true;
 }
 
 // add a new structure; assumes none with the same name
@@ -106,22 +94,15 @@ shared_ptr<Structure> Model::get_structure_ptr(const std::string& name) const
   return it->second;
 }
 
-shared_ptr<Structure> Model::find_closest_structure(shared_ptr<Agent> agent) const
+shared_ptr<Structure> Model::find_closest_structure(const Agent& agent) const
 {
   // If we don't have any structures, return an empty shared_ptr.
   if (structures.empty()) {
     return shared_ptr<Structure>();
   }
   
-  auto closest_structure_it =
-      std::min_element(structures.begin(),
-                       structures.end(),
-                       std::bind(sim_object_min_distance_comparator,
-                                 agent,
-                                 std::bind(&Structure_c::value_type::second, _1),
-                                 std::bind(&Structure_c::value_type::second, _2)));
-  
-  return closest_structure_it->second;
+  refresh_structure_tree();
+  return structure_entries[structure_tree->nearest(agent.get_location())];
 }
 
 // is there an agent with this name?
@@ -134,6 +115,7 @@ void Model::add_agent_helper(shared_ptr<Agent>agent)
 {
   all_objects.insert(std::make_pair(agent->get_name(), agent));
   agents.insert(std::make_pair(agent->get_name(), agent));
+  agents_changed = true;
 }
 
 // add a new agent; assumes none with the same name
@@ -157,9 +139,13 @@ void Model::remove_agent(shared_ptr<Agent> agent)
 {
   all_objects.erase(agent->get_name());
   agents.erase(agent->get_name());
+  // the tree's entries must not keep a removed agent alive for its attackers' weak_ptrs
+  agent_entries.clear();
+  agent_numbers.clear();
+  agents_changed = true;
 }
 
-shared_ptr<Agent> Model::find_closest_agent(std::shared_ptr<Agent> agent) const
+shared_ptr<Agent> Model::find_closest_agent(const Agent& agent) const
 {
   // If there's only one agent in our container, it must be the same as the 'agent'
   // argument. Return an empty shared_ptr.
@@ -167,15 +153,52 @@ shared_ptr<Agent> Model::find_closest_agent(std::shared_ptr<Agent> agent) const
     return shared_ptr<Agent>();
   }
   
-  auto closest_agent_it =
-      std::min_element(agents.begin(),
-                       agents.end(),
-                       std::bind(sim_object_min_distance_comparator,
-                                 agent,
-                                 std::bind(&Agent_c::value_type::second, _1),
-                                 std::bind(&Agent_c::value_type::second, _2)));
+  refresh_agent_tree();
+  auto number_it = agent_numbers.find(agent.get_name());
+  int closest = agent_tree->nearest(agent.get_location(),
+                                    number_it == agent_numbers.end() ? -1 : number_it->second);
+  return closest == -1 ? shared_ptr<Agent>() : agent_entries[closest];
+}
+
+// Number the agents in name order and build the tree over them if any have come or
+// gone, or just build the tree again if it has had as many moves as there are agents.
+void Model::refresh_agent_tree() const
+{
+  if (agents_changed) {
+    agent_entries.clear();
+    agent_numbers.clear();
+    for (Agent_c::const_iterator it = agents.begin(); it != agents.end(); ++it) {
+      agent_numbers[it->first] = int(agent_entries.size());
+      agent_entries.push_back(it->second);
+    }
+  } else if (agent_moves < agent_tree->size()) {
+    return;
+  }
   
-  return closest_agent_it->second;
+  vector<Point> locations;
+  locations.reserve(agent_entries.size());
+  for (auto& entry : agent_entries) {
+    locations.push_back(entry->get_location());
+  }
+  agent_tree->build(locations);
+  agents_changed = false;
+  agent_moves = 0;
+}
+
+// Structures never move, so their tree only changes when one is added.
+void Model::refresh_structure_tree() const
+{
+  if (!structures_changed) {
+    return;
+  }
+  structure_entries.clear();
+  vector<Point> locations;
+  for (Structure_c::const_iterator it = structures.begin(); it != structures.end(); ++it) {
+    structure_entries.push_back(it->second);
+    locations.push_back(it->second->get_location());
+  }
+  structure_tree->build(locations);
+  structures_changed = false;
 }
 
 // tell all objects to describe themselves to the console
@@ -223,6 +246,14 @@ void Model::notify_health(const std::string &name, int health)
 
 void Model::notify_location(const std::string& name, Point location)
 {
+  // Keep the agent tree, if it is current, up with the move.
+  if (!agents_changed) {
+    auto number_it = agent_numbers.find(name);
+    if (number_it != agent_numbers.end()) {
+      agent_tree->move(number_it->second, location);
+      ++agent_moves;
+    }
+  }
   std::for_each(views.begin(), views.end(), bind(&View::update_location, _1, name, location) );
 }
 
@@ -19,8 +19,11 @@ Notice how only the Standard Library headers need to be included - reduced coupl
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class Agent;
+class Kd_tree;
 class Sim_object;
 class Structure;
 class View;
@@ -31,6 +34,8 @@ class Model {
 public:
   // Provide the singleton accessor.
   static Model& getInstance();
+  
+  ~Model();
 
 	// return the current time
 	int get_time() {return time;}
@@ -46,7 +51,7 @@ public:
 	// will throw Error("Structure not found!") if no structure of that name
   std::shared_ptr<Structure> get_structure_ptr(const std::string& name) const;
   // find structure closest to given location
-  std::shared_ptr<Structure> find_closest_structure(std::shared_ptr<Agent>) const;
+  std::shared_ptr<Structure> find_closest_structure(const Agent&) const;
 
 	// is there an agent with this name?
 	bool is_agent_present(const std::string& name) const;
@@ -57,7 +62,7 @@ public:
   // remove Agent from containers
   void remove_agent(std::shared_ptr<Agent>);
   // find agent closest to given location
-  std::shared_ptr<Agent> find_closest_agent(std::shared_ptr<Agent>) const;
+  std::shared_ptr<Agent> find_closest_agent(const Agent&) const;
 	
 	// tell all objects to describe themselves to the console
 	void describe() const;
@@ -91,6 +96,20 @@ private:
   // View container.
   std::set<std::shared_ptr<View>> views;
   
+  // Trees for the closest object searches, over the objects in name order, so that
+  // the first of equally close objects is found as before. They are built when
+  // first needed after objects come or go. Agent moves are applied to the agent
+  // tree as they are notified, and it is built again once there have been as many
+  // moves as agents, before its rectangles get too loose.
+  mutable std::unique_ptr<Kd_tree> agent_tree;
+  mutable std::vector<std::shared_ptr<Agent>> agent_entries;
+  mutable std::unordered_map<std::string, int> agent_numbers;
+  mutable bool agents_changed {true};
+  mutable int agent_moves {0};
+  mutable std::unique_ptr<Kd_tree> structure_tree;
+  mutable std::vector<std::shared_ptr<Structure>> structure_entries;
+  mutable bool structures_changed {true};
+  
   // Make constructor private, as this is a singleton.
   Model();
 
@@ -102,4 +121,8 @@ private:
   
   void add_agent_helper(std::shared_ptr<Agent> agent);
   void add_structure_helper(std::shared_ptr<Structure> structure);
+  
+  // bring the trees up to date with the objects
+  void refresh_agent_tree() const;
+  void refresh_structure_tree() const;
 };
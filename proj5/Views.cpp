@@ -34,11 +34,46 @@ using std::cout; using std::endl;
 #define HEALTH_VIEW_NAME "Health"
 
 using Grid = vector< vector <string> >;
-using Locations_c = map<string, Point>;
 
 // Default destructor for View.
 View::~View() {}
 
+void LocationStore::update(const std::string& name, Point location)
+{
+  if (name == last_name && location == last_location) {
+    return;
+  }
+  last_name = name;
+  last_location = location;
+  
+  auto slot_it = slots.find(name);
+  if (slot_it == slots.end()) {
+    int slot;
+    if (free_slots.empty()) {
+      slot = int(entries.size());
+      entries.push_back(Entry{location, 0});
+    } else {
+      slot = free_slots.back();
+      free_slots.pop_back();
+    }
+    slots.insert({name, slot});
+    entries[slot] = Entry{location, ++next_version};
+  } else if (!(entries[slot_it->second].location == location)) {
+    entries[slot_it->second] = Entry{location, ++next_version};
+  }
+}
+
+void LocationStore::remove(const std::string& name)
+{
+  auto slot_it = slots.find(name);
+  if (slot_it == slots.end()) {
+    return;
+  }
+  free_slots.push_back(slot_it->second);
+  slots.erase(slot_it);
+  last_name.clear();
+}
+
 // Default destructor for LocationView.
 LocationView::~LocationView() {}
 
@@ -46,13 +81,13 @@ LocationView::~LocationView() {}
 // If the name is already present,the new location replaces the previous one.
 void LocationView::update_location(const std::string& name, Point location)
 {
-  locations[name] = location;
+  store->update(name, location);
 }
 
 // Remove the name and its location; no error if the name is not present.
 void LocationView::update_remove(const std::string& name)
 {
-  locations.erase(name);
+  store->remove(name);
 }
 
 // prints out the current map
@@ -63,16 +98,20 @@ void LocationView::draw()
   Grid grid(size, row);
   
   // Populate grid.
-  std::for_each(locations.begin(), locations.end(), [&] (Locations_c::value_type pair) {
-    int ix, iy;
-    if (this->get_subscripts(ix, iy, pair.second)) {
-      if (grid[iy][ix] == EMPTY_CELL_STRING) {
-        grid[iy][ix] = pair.first.substr(0, UNIQUE_STRING_PREFIX_SIZE);
+  for (auto& slot_pair : store->get_slots()) {
+    if (is_cleared(slot_pair.second)) {
+      continue;
+    }
+    const Projection& projection = get_projection(slot_pair.second);
+    if (projection.on_grid) {
+      string& cell = grid[projection.iy][projection.ix];
+      if (cell == EMPTY_CELL_STRING) {
+        cell = slot_pair.first.substr(0, UNIQUE_STRING_PREFIX_SIZE);
       } else {
-        grid[iy][ix] = MULTIPLE_OCCUPANTS_CELL_STRING;
+        cell = MULTIPLE_OCCUPANTS_CELL_STRING;
       }
     }
-  });
+  }
  
   int old_precision = cout.precision(); 
   cout.precision(0);
@@ -98,9 +137,11 @@ void LocationView::draw()
 }
 
 // Discard the saved information - drawing will show only a empty pattern
+// The store is shared, so only this view stops showing what it holds now.
 void LocationView::clear()
 {
-  locations.clear();
+  cleared_through = store->get_version();
+  projections.clear();
 }
 
 // modify the display parameters
@@ -115,6 +156,7 @@ void LocationView::set_size(int size_)
     throw Error{"New map size is too small!"};
   }
   size = size_;
+  ++generation;
 }
 
 // If scale is not postive, will throw Error("New map scale must be positive!");
@@ -124,18 +166,21 @@ void LocationView::set_scale(double scale_)
     throw Error{"New map scale must be positive!"};
   }
   scale = scale_;
+  ++generation;
 }
 
 // any values are legal for the origin
 void LocationView::set_origin(Point origin_)
 {
   origin = origin_;
+  ++generation;
 }
 
 void LocationView::set_center(Point center)
 {
   origin.x = center.x - (size/2.)*scale;
   origin.y = center.y - (size/2.)*scale;
+  ++generation;
 }
 
 // Service for derived views.
@@ -150,12 +195,11 @@ void LocationView::print_objects_offscreen() const
 {
   // Populate objects off screen.
   vector<string> objects_off_screen;
-  std::for_each(locations.begin(), locations.end(), [&] (Locations_c::value_type pair) {
-    int ix, iy;
-    if (!(this->get_subscripts(ix, iy, pair.second))) {
-      objects_off_screen.push_back(pair.first);
+  for (auto& slot_pair : store->get_slots()) {
+    if (!is_cleared(slot_pair.second) && !get_projection(slot_pair.second).on_grid) {
+      objects_off_screen.push_back(slot_pair.first);
     }
-  });
+  }
   
   // Print objects off screen.
   if (!objects_off_screen.empty()) {
@@ -167,6 +211,23 @@ void LocationView::print_objects_offscreen() const
   }
 }
 
+// Return the subscripts of the object in the slot, computing them again only if the
+// object has moved or the view has changed since they were last computed.
+const LocationView::Projection& LocationView::get_projection(int slot) const
+{
+  if (slot >= int(projections.size())) {
+    projections.resize(slot + 1, Projection{0, 0, false, 0, 0});
+  }
+  Projection& projection = projections[slot];
+  const LocationStore::Entry& entry = store->get_entry(slot);
+  if (projection.version != entry.version || projection.generation != generation) {
+    projection.on_grid = get_subscripts(projection.ix, projection.iy, entry.location);
+    projection.version = entry.version;
+    projection.generation = generation;
+  }
+  return projection;
+}
+
 // Calculate the cell subscripts corresponding to the supplied location parameter,
 // using the current size, scale, and origin of the display.
 // This function assumes that origin is a  member variable of type Point,
@@ -190,7 +251,8 @@ bool LocationView::get_subscripts(int &ix, int &iy, Point location) const
 		return true;
 }
 
-MapView::MapView(const string& name_) : LocationView(name_)
+MapView::MapView(const string& name_, std::shared_ptr<LocationStore> store_)
+    : LocationView(name_, store_)
 {
   set_defaults();
 }
@@ -213,7 +275,8 @@ void MapView::set_defaults()
   set_origin(Point(DEFAULT_MAP_VIEW_ORIGIN_X, DEFAULT_MAP_VIEW_ORIGIN_Y));
 }
 
-LocalView::LocalView(const string& name_) : LocationView(name_)
+LocalView::LocalView(const string& name_, std::shared_ptr<LocationStore> store_)
+    : LocationView(name_, store_)
 {
   set_size(LOCAL_VIEW_SIZE);
   set_scale(LOCAL_VIEW_SCALE);
@@ -238,9 +301,25 @@ void LocalView::draw()
 // Default constructor for AttributeView.
 AttributeView::~AttributeView() {}
 
+bool AttributeView::Value_less::operator() (int a, int b) const
+{
+  if (view->values[a] != view->values[b]) {
+    return view->values[a] < view->values[b];
+  }
+  return *view->names[a] < *view->names[b];
+}
+
 void AttributeView::update_remove(const std::string &name)
 {
-  attributes.erase(name);
+  auto row_it = rows.find(name);
+  if (row_it == rows.end()) {
+    return;
+  }
+  int row = row_it->second;
+  by_value.erase(row);
+  total -= values[row];
+  free_rows.push_back(row);
+  rows.erase(row_it);
 }
 
 // Draw the 'table' of current attributes.
@@ -250,22 +329,109 @@ void AttributeView::draw()
   
   cout << "Current " << get_attribute_name() << ":" << endl;
   cout << "--------------" << endl;
-  for (auto attribute_pair : attributes) {
-    cout << attribute_pair.first << ": " << attribute_pair.second << endl;
+  for (auto& row_pair : rows) {
+    print_row(row_pair.second);
   }
   cout << "--------------" << endl;
 
   cout.precision(old_precision);
 }
 
+void AttributeView::draw_summary() const
+{
+  if (rows.empty()) {
+    cout << "No " << get_attribute_name() << " to summarize" << endl;
+    return;
+  }
+  cout << "Min: " << values[*by_value.begin()] << ", Max: " << values[*by_value.rbegin()]
+      << ", Mean: " << double(total / rows.size()) << endl;
+}
+
+void AttributeView::draw_lowest(int count) const
+{
+  if (count <= 0) {
+    throw Error{"Count must be positive!"};
+  }
+  cout << "Lowest " << count << " " << get_attribute_name() << ":" << endl;
+  cout << "--------------" << endl;
+  for (auto it = by_value.begin(); it != by_value.end() && count > 0; ++it, --count) {
+    print_row(*it);
+  }
+  cout << "--------------" << endl;
+}
+
+void AttributeView::draw_highest(int count) const
+{
+  if (count <= 0) {
+    throw Error{"Count must be positive!"};
+  }
+  cout << "Highest " << count << " " << get_attribute_name() << ":" << endl;
+  cout << "--------------" << endl;
+  for (auto it = by_value.rbegin(); it != by_value.rend() && count > 0; ++it, --count) {
+    print_row(*it);
+  }
+  cout << "--------------" << endl;
+}
+
+void AttributeView::draw_above(double threshold) const
+{
+  cout << get_attribute_name() << " above " << threshold << ":" << endl;
+  cout << "--------------" << endl;
+  for (auto it = by_value.rbegin(); it != by_value.rend() && values[*it] > threshold; ++it) {
+    print_row(*it);
+  }
+  cout << "--------------" << endl;
+}
+
+void AttributeView::draw_below(double threshold) const
+{
+  cout << get_attribute_name() << " below " << threshold << ":" << endl;
+  cout << "--------------" << endl;
+  for (auto it = by_value.begin(); it != by_value.end() && values[*it] < threshold; ++it) {
+    print_row(*it);
+  }
+  cout << "--------------" << endl;
+}
+
 void AttributeView::clear()
 {
-  attributes.clear();
+  rows.clear();
+  names.clear();
+  values.clear();
+  free_rows.clear();
+  by_value.clear();
+  total = 0;
 }
 
+// Keep the value indexes in step: the row leaves the value index before its value
+// changes and goes back in afterwards.
 void AttributeView::set_attribute(const std::string &name, double attribute)
 {
-  attributes[name] = attribute;
+  auto row_it = rows.find(name);
+  if (row_it == rows.end()) {
+    int row;
+    if (free_rows.empty()) {
+      row = int(values.size());
+      names.push_back(nullptr);
+      values.push_back(attribute);
+    } else {
+      row = free_rows.back();
+      free_rows.pop_back();
+    }
+    row_it = rows.insert({name, row}).first;
+    names[row] = &row_it->first;
+  } else {
+    by_value.erase(row_it->second);
+    total -= values[row_it->second];
+  }
+  values[row_it->second] = attribute;
+  total += attribute;
+  by_value.insert(row_it->second);
+}
+
+void AttributeView::print_row(int row) const
+{
+  cout << *names[row] << ": " << values[row] << endl;
 }
 
 void HealthView::update_health(const std::string &name, double health)
@@ -273,7 +439,7 @@ void HealthView::update_health(const std::string &name, double health)
   set_attribute(name, health);
 }
 
-string HealthView::get_attribute_name()
+string HealthView::get_attribute_name() const
 {
   return HEALTH_VIEW_NAME;
 }
@@ -283,7 +449,7 @@ void AmountView::update_amount(const std::string &name, double amount)
   set_attribute(name, amount);
 }
 
-string AmountView::get_attribute_name()
+string AmountView::get_attribute_name() const
 {
   return AMOUNTS_VIEW_NAME;
 }
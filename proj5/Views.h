@@ -6,6 +6,8 @@
 #include "Geometry.h"
 
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -44,10 +46,54 @@ private:
   std::string name;
 };
 
+/* LocationStore holds the world position of every object for all of the location
+views that share it. Each entry lives in a fixed slot and gets a new version number
+whenever it moves, so a view can tell when its cached subscripts are stale. */
+class LocationStore {
+public:
+  
+  struct Entry {
+    Point location;
+    unsigned version;
+  };
+  
+  using Slots_c = std::map<std::string, int>;
+  
+  // Save the location; every view passes on the same notification, so a repeat of the
+  // last one is ignored without a lookup.
+  void update(const std::string& name, Point location);
+  
+  // Forget the name; no error if the name is not present.
+  void remove(const std::string& name);
+  
+  // The slot of each object, in name order.
+  const Slots_c& get_slots() const
+      { return slots; }
+  
+  const Entry& get_entry(int slot) const
+      { return entries[slot]; }
+  
+  // The version given to the most recent change.
+  unsigned get_version() const
+      { return next_version; }
+  
+private:
+  
+  Slots_c slots;
+  std::vector<Entry> entries;
+  std::vector<int> free_slots;
+  unsigned next_version = 0;
+  
+  std::string last_name;
+  Point last_location;
+};
+
 class LocationView : public View {
 public:
   
-  LocationView(const std::string& name_) : View(name_) {}
+  // All location views given the same store share one copy of every position.
+  LocationView(const std::string& name_, std::shared_ptr<LocationStore> store_)
+      : View(name_), store{store_} {}
   
   // Make this class abstract.
   virtual ~LocationView() = 0;
@@ -61,7 +107,8 @@ public:
   // Draw the view using a grid layout.
   void draw() override;
   
-  // Remove all objects.
+  // Stop showing the objects now in the store. The store and other views sharing it
+  // are left alone; an object shows again here once its location changes.
   void clear() override;
   
 protected:
@@ -92,7 +139,25 @@ private:
   Point origin;
   double scale;
   int size;  // Number of rows/columns in the grid
-  std::map<std::string, Point> locations;
+  std::shared_ptr<LocationStore> store;
+  
+  // Cached subscripts of each store slot. An entry is good while both the object's
+  // version and the view's generation match; changing size, scale or origin starts a
+  // new generation.
+  struct Projection {
+    int ix, iy;
+    bool on_grid;
+    unsigned version;
+    unsigned generation;
+  };
+  mutable std::vector<Projection> projections;
+  unsigned generation = 1;
+  unsigned cleared_through = 0;  // store versions up to this one were cleared
+  
+  bool is_cleared(int slot) const
+      { return store->get_entry(slot).version <= cleared_through; }
+  
+  const Projection& get_projection(int slot) const;
   
   bool get_subscripts(int &ix, int &iy, Point location) const;
 };
@@ -101,7 +166,7 @@ class MapView : public LocationView {
 public:
   
   // Set up scale and such in constructor.
-  MapView(const std::string& name_);
+  MapView(const std::string& name_, std::shared_ptr<LocationStore> store_);
   
   void draw() override;
   
@@ -121,7 +186,7 @@ public:
 class LocalView : public LocationView {
 public:
   
-  LocalView(const std::string& name_);
+  LocalView(const std::string& name_, std::shared_ptr<LocationStore> store_);
   
   // Override the update_location method to update the origin.
   void update_location(const std::string& name, Point location) override;
@@ -129,10 +194,13 @@ public:
   void draw() override;
 };
 
+/* AttributeView keeps one value per object in columns: a row per object, found through
+a name index kept in name order and a value index kept in value order. Both indexes
+are updated as values change, so the queries below only visit the rows they print. */
 class AttributeView : public View {
 public:
   
-  AttributeView(const std::string name_) : View(name_) {}
+  AttributeView(const std::string name_) : View(name_), by_value{Value_less{this}} {}
   
   virtual ~AttributeView() = 0;
   
@@ -143,16 +211,42 @@ public:
   
   void clear() override;
   
+  // Print the count objects with the lowest or highest values, starting from the extreme.
+  // Throws Error if count is not positive.
+  void draw_lowest(int count) const;
+  void draw_highest(int count) const;
+  
+  // Print the objects with values strictly above or below the threshold, starting
+  // from the extreme.
+  void draw_above(double threshold) const;
+  void draw_below(double threshold) const;
+  
+  // Print the minimum, maximum and mean of the values.
+  void draw_summary() const;
+  
 protected:
   // Let subclasses add/alter an attribute.
   void set_attribute(const std::string& name, double attribute);
   
 private:
   
-  std::map<std::string, double> attributes;
+  // orders rows by value, then by name
+  struct Value_less {
+    const AttributeView* view;
+    bool operator() (int a, int b) const;
+  };
+  
+  std::map<std::string, int> rows;
+  std::vector<const std::string*> names;  // the key in rows, by row
+  std::vector<double> values;  // by row
+  std::vector<int> free_rows;
+  std::set<int, Value_less> by_value;
+  long double total = 0;
+  
+  void print_row(int row) const;
   
   // Subclasses must return the type of attribute.
-  virtual std::string get_attribute_name() = 0;
+  virtual std::string get_attribute_name() const = 0;
 };
 
 class HealthView : public AttributeView {
@@ -162,7 +256,7 @@ public:
   
   void update_health(const std::string& name, double health) override;
     
-  std::string get_attribute_name() override;
+  std::string get_attribute_name() const override;
 };
 
 class AmountView : public AttributeView {
@@ -172,7 +266,7 @@ public:
     
   void update_amount(const std::string& name, double amount) override;
   
-  std::string get_attribute_name() override;
+  std::string get_attribute_name() const override;
 };
 
 #endif
@@ -56,7 +56,7 @@ void Warrior::update()
   
   // Attack!
   cout << get_name() << ": " << get_battle_cry() << endl;
-  target_ptr->take_hit(attack_strength, shared_from_this());
+  target_ptr->take_hit(attack_strength, *this);
   
   // Did we just kill it?
   if (!target_ptr->is_alive()) {
@@ -69,9 +69,9 @@ void Warrior::update()
 // Make this Soldier start attacking the target Agent.
 // Throws an exception if the target is the same as this Agent,
 // is out of range, or is not alive.
-void Warrior::start_attacking(shared_ptr<Agent> target_ptr)
+void Warrior::start_attacking(const shared_ptr<Agent>& target_ptr)
 {
-  if (target_ptr == shared_from_this()) {
+  if (target_ptr.get() == this) {
     throw Error{ get_name() + ": I cannot attack myself!" };
   }
   
@@ -86,7 +86,7 @@ void Warrior::start_attacking(shared_ptr<Agent> target_ptr)
   attack(target_ptr);
 }
 
-void Warrior::attack(shared_ptr<Agent> target_ptr)
+void Warrior::attack(const shared_ptr<Agent>& target_ptr)
 {
   cout << get_name() << ": I'm attacking!" << endl;
   target = target_ptr;
@@ -119,13 +119,13 @@ Soldier::Soldier(const std::string& name_, Point location_)
     : Warrior(name_, location_, SOLDIER_ATTACK_STRENGTH, SOLDIER_ATTACK_RANGE) {}
 
 // Overrides Agent's take_hit to counterattack when attacked.
-void Soldier::take_hit(int attack_strength, shared_ptr<Agent> attacker_ptr)
+void Soldier::take_hit(int attack_strength, Agent& attacker)
 {
-  Agent::take_hit(attack_strength, attacker_ptr);
+  Agent::take_hit(attack_strength, attacker);
   
-  if (is_alive() && !is_attacking() && attacker_ptr->is_alive()) {
-    // Hit back!
-    attack(attacker_ptr);
+  if (is_alive() && !is_attacking() && attacker.is_alive()) {
+    // Hit back! Only now is an owning pointer to the attacker needed, to remember it.
+    attack(attacker.shared_from_this());
   }
 }
 
@@ -150,7 +150,7 @@ void Archer::update()
   
   // If we aren't attacking, look for someone to shoot!
   if (!is_attacking()) {
-    auto closest_agent = Model::getInstance().find_closest_agent(shared_from_this());
+    auto closest_agent = Model::getInstance().find_closest_agent(*this);
     
     // Validate closest_agent, then make sure closest_agent is within range.
     if (!closest_agent ||
@@ -161,13 +161,13 @@ void Archer::update()
   }
 }
 
-void Archer::take_hit(int attack_strength, shared_ptr<Agent> attacker_ptr)
+void Archer::take_hit(int attack_strength, Agent& attacker)
 {
-  Agent::take_hit(attack_strength, attacker_ptr);
+  Agent::take_hit(attack_strength, attacker);
   
-  if (is_alive() && attacker_ptr->is_alive()) {
+  if (is_alive() && attacker.is_alive()) {
     // Run away!
-    auto closest_structure = Model::getInstance().find_closest_structure(shared_from_this());
+    auto closest_structure = Model::getInstance().find_closest_structure(*this);
     if (!closest_structure) {
       return;
     }
@@ -28,7 +28,7 @@ public:
   // Make this Warrior start attacking the target Agent.
 	// Throws an exception if the target is the same as this Agent,
 	// is out of range, or is not alive.
-  void start_attacking(std::shared_ptr<Agent> target_ptr) override;
+  void start_attacking(const std::shared_ptr<Agent>& target_ptr) override;
   
   // Overrides Agent's stop to print a message
   void stop() override;
@@ -42,7 +42,7 @@ protected:
       { return state == ATTACKING; }
   
   // Attack the given agent, regardless of if its status (in range, alive, etc.)
-  void attack(std::shared_ptr<Agent> target_ptr);
+  void attack(const std::shared_ptr<Agent>& target_ptr);
   
 private:
   typedef enum {
@@ -65,7 +65,7 @@ public:
 	Soldier(const std::string& name_, Point location_);
 		
 	// Overrides Agent's take_hit to counterattack when attacked.
-	void take_hit(int attack_strength, std::shared_ptr<Agent> attacker_ptr) override;
+	void take_hit(int attack_strength, Agent& attacker) override;
 	
 	// output information specific to soldier
 	void describe() const override;
@@ -83,7 +83,7 @@ public:
   void update() override;
   
   // Overrides Agent's take_hit to run away to the nearest Structure when attacked.
-  void take_hit(int attack_strength, std::shared_ptr<Agent> attacker) override;
+  void take_hit(int attack_strength, Agent& attacker) override;
   
   // output information specific to archer
   void describe() const override;
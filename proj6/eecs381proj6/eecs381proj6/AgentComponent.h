@@ -13,6 +13,7 @@
 #include "Utility.h"
 #include "Geometry.h"
 
+#include <set>
 #include <string>
 #include <memory>
 #include <vector>
@@ -30,19 +31,20 @@ public:
   // all individuals and groups must have a name
   virtual const std::string &get_name() const = 0;
   
-  // does any one in this component have this prefix?
-  virtual bool has_prefix(const std::string& prefix) = 0;
+  // groups are always alive, individuals override to report their own state
+  virtual bool is_alive() const
+      { return true; }
   
   // subclasses may override, default is just to give name
   virtual const std::string get_printed_name() const
       { return get_name(); }
 
-  // get the nearest agent in the group, or none if no one is in range
-  virtual std::shared_ptr<AgentIndividual> get_nearest_in_range(std::shared_ptr<const Sim_object> origin,
-                                                                double range) = 0;
+  // get the nearest agent in the group, or nullptr if no one is in range; the pointer
+  // does not own the agent and is only good until the Model next removes agents
+  virtual AgentIndividual* get_nearest_in_range(const Sim_object& origin, double range) = 0;
   
   // get the nearest agents in range
-  virtual std::shared_ptr<AgentComponent> get_all_in_range(std::shared_ptr<const Sim_object> origin,
+  virtual std::shared_ptr<AgentComponent> get_all_in_range(const Sim_object& origin,
                                                            double range) = 0;
   
 	// tell this AgentComponent to start moving to location destination_
@@ -57,7 +59,7 @@ public:
 	virtual void start_working(std::shared_ptr<Structure>, std::shared_ptr<Structure>) = 0;
   
 	// tell the component to start attacking
-	virtual void start_attacking(std::shared_ptr<AgentComponent>) = 0;
+	virtual void start_attacking(const std::shared_ptr<AgentComponent>&) = 0;
   
   // Tell this AgentComponent to accept a blessing from an agent specified by blesser_ptr.
   // A derived class must override this function.
@@ -74,8 +76,8 @@ public:
   virtual void remove_component(const std::string& name_)
     { throw Error("This agent cannot remove components!"); }
   
-  // remove component if present in this group or ANY subgroup, does not throw Error
-  virtual void remove_component_if_present(const std::string& name_) {}
+  // remove every named component present in this group or ANY subgroup, does not throw Error
+  virtual void remove_components_if_present(const std::set<std::string>& names) {}
   
   // clear out group and put agents back in model root
   virtual void disband()
@@ -2,6 +2,7 @@
 
 #include "AgentIndividual.h"
 #include "Geometry.h"
+#include "Geometry_kernels.h"
 #include "Model.h"
 #include "Utility.h"
 
@@ -11,49 +12,38 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 using namespace std::placeholders; using std::bind;
-using std::vector; using std::map; using std::string;
-using std::cout; using std::endl;
+using std::vector; using std::map; using std::set; using std::string;
+using std::endl;
 using std::function;
 using std::shared_ptr; using std::make_shared;
 
 AgentGroup::AgentGroup(const std::string &name_) :
     group_name{name_} {}
 
-// does any one in the group have this prefix?
-bool AgentGroup::has_prefix(const std::string& prefix)
-{
-  for (auto& component: group_components) {
-    if (component.second->has_prefix(prefix)) {
-      return true;
-    }
-  }
-  return false;
-}
-
 // iterate over the contained components and handle errors
 void AgentGroup::iterate_and_catch(function<void(AgentComponent*)> func) {
   for (auto& component : group_components) {
     try {
       func(component.second.get());
     } catch (Error &e) {
-      cout << e.msg << endl;
+      Model::get().out() << e.msg << endl;
     }
   }
 }
 
 // get the nearest agent individual in the group
-shared_ptr<AgentIndividual> AgentGroup::get_nearest_in_range(shared_ptr<const Sim_object> origin,
-                                                             double range) {
-  shared_ptr<AgentIndividual> best;
+AgentIndividual* AgentGroup::get_nearest_in_range(const Sim_object& origin, double range) {
+  AgentIndividual* best = nullptr;
   for (auto& component : group_components) {
     auto cur = component.second->get_nearest_in_range(origin, range);
     
     // Make sure cur is valid and different than our origin argument.
-    if (!cur || origin->get_name() == cur->get_name()) {
+    if (!cur || origin.get_name() == cur->get_name()) {
       continue;
     }
     
@@ -62,8 +52,8 @@ shared_ptr<AgentIndividual> AgentGroup::get_nearest_in_range(shared_ptr<const Si
       best = cur;
     } else {
       // Otherwise, compare distances to see who is closer.     
-      if (cartesian_distance(origin->get_location(), cur->get_location()) <
-          cartesian_distance(origin->get_location(), best->get_location())) {
+      if (cartesian_distance_squared(origin.get_location(), cur->get_location()) <
+          cartesian_distance_squared(origin.get_location(), best->get_location())) {
         best = cur;
       }
     }
@@ -72,13 +62,13 @@ shared_ptr<AgentIndividual> AgentGroup::get_nearest_in_range(shared_ptr<const Si
 }
 
 // get the nearest agents in range, excluding the 'origin' sim_object
-shared_ptr<AgentComponent> AgentGroup::get_all_in_range(shared_ptr<const Sim_object> origin,
+shared_ptr<AgentComponent> AgentGroup::get_all_in_range(const Sim_object& origin,
                                                         double range)
 {
   auto agents_in_range = make_shared<AgentGroup>("temp");
   for (auto& component : group_components) {
     auto component_in_range = component.second->get_all_in_range(origin, range);
-    if (component_in_range && component_in_range->get_name() != origin->get_name()) {
+    if (component_in_range && component_in_range->get_name() != origin.get_name()) {
       agents_in_range->add_component(component_in_range);
     }
   }
@@ -101,16 +91,16 @@ void AgentGroup::start_working(std::shared_ptr<Structure> s1, std::shared_ptr<St
 {
   // Notify the user that this group is empty.
   if (group_components.empty()) {
-    cout << get_printed_name() << " is empty. Not working." << endl;
+    Model::get().out() << get_printed_name() << " is empty. Not working." << endl;
   }
   iterate_and_catch(bind(&AgentComponent::start_working, _1, s1, s2));
 }
 
-void AgentGroup::start_attacking(std::shared_ptr<AgentComponent> target)
+void AgentGroup::start_attacking(const std::shared_ptr<AgentComponent>& target)
 {
   // Notify the user that this group is empty.
   if (group_components.empty()) {
-    cout << get_printed_name() << " is empty. Not attacking." << endl;
+    Model::get().out() << get_printed_name() << " is empty. Not attacking." << endl;
   }
   iterate_and_catch(bind(&AgentComponent::start_attacking, _1, target));
 }
@@ -168,16 +158,18 @@ void AgentGroup::remove_component(const string& name_)
   }
 }
 
-void AgentGroup::remove_component_if_present(const std::string& name_)
+void AgentGroup::remove_components_if_present(const std::set<std::string>& names)
 {
-  if (group_components.erase(name_)) {
-    // We found it and erased it. Get out.
-    return;
-  }
-  
-  // Otherwise, remove components iteratively.
-  for (auto& component : group_components) {
-    component.second->remove_component_if_present(name_);
+  auto itr = group_components.begin();
+  while (itr != group_components.end()) {
+    if (names.count(itr->first)) {
+      // Named directly, erase it and move on.
+      itr = group_components.erase(itr);
+    } else {
+      // Otherwise, let any subgroup remove its own members.
+      itr->second->remove_components_if_present(names);
+      ++itr;
+    }
   }
 }
 
@@ -28,18 +28,14 @@ public:
   const std::string get_printed_name() const override
     { return "Group " + group_name; }
   
-  // does any one in the group have this prefix?
-  bool has_prefix(const std::string& prefix) override;
-  
   // iterate over the contained components and handle errors
   void iterate_and_catch(std::function<void(AgentComponent*)> func);
   
   // get the nearest agent individual
-  std::shared_ptr<AgentIndividual> get_nearest_in_range(std::shared_ptr<const Sim_object> origin,
-                                                        double range) override;
+  AgentIndividual* get_nearest_in_range(const Sim_object& origin, double range) override;
   
   // get the nearest agent component within a range
-  std::shared_ptr<AgentComponent> get_all_in_range(std::shared_ptr<const Sim_object> origin,
+  std::shared_ptr<AgentComponent> get_all_in_range(const Sim_object& origin,
                                                    double range) override;
   
 	// tell this AgentComponent to start moving to location destination_
@@ -54,7 +50,7 @@ public:
 	void start_working(std::shared_ptr<Structure>, std::shared_ptr<Structure>) override;
   
 	// Throws exception that an AgentComponent cannot attack.
-	void start_attacking(std::shared_ptr<AgentComponent>) override;
+	void start_attacking(const std::shared_ptr<AgentComponent>&) override;
 
   // Accept a blessing. Calls accept_blessing for all group members.
   void accept_blessing(int blessing_strength, std::shared_ptr<AgentIndividual> blesser_ptr) override;
@@ -68,8 +64,8 @@ public:
   // remove component
   void remove_component(const std::string& name_) override;
 
-  // remove component only if present, does not throw Error
-  void remove_component_if_present(const std::string& name_) override;
+  // remove the named components wherever present, walking each subgroup once; does not throw Error
+  void remove_components_if_present(const std::set<std::string>& names) override;
 
   // put children back in the model
   void disband() override;
@@ -9,7 +9,7 @@
 #include <vector>
 
 using std::string; using std::vector;
-using std::cout; using std::endl;
+using std::endl;
 using std::shared_ptr;
 
 const double DEFAULT_SPEED = 5.0;
@@ -18,17 +18,12 @@ const int INITIAL_HEALTH = 5;
 AgentIndividual::AgentIndividual(const string& in_name, Point in_location) :
   Sim_object{in_name},
   Moving_object{in_location, DEFAULT_SPEED},
-  health{INITIAL_HEALTH},
-  alive{true} {}
+  alive{true},
+  health{INITIAL_HEALTH} {}
 
 // Explicit default destructor.
 AgentIndividual::~AgentIndividual() {}
 
-bool AgentIndividual::has_prefix(const std::string &prefix)
-{
-  return get_name().substr(0, prefix.size()) == prefix;
-}
-
 bool in_range(Point p1, Point p2, double range)
 {
   if (cartesian_distance(p1, p2) > range) {
@@ -37,22 +32,21 @@ bool in_range(Point p1, Point p2, double range)
   return true;
 }
 
-// get shared_from_this
-shared_ptr<AgentIndividual> AgentIndividual::get_nearest_in_range(shared_ptr<const Sim_object> origin,
-                                                                  double range)
+// this agent, if it is in range; dead agents awaiting removal are never in range
+AgentIndividual* AgentIndividual::get_nearest_in_range(const Sim_object& origin, double range)
 {
-  if (in_range(origin->get_location(), get_location(), range)) {
-    return {shared_from_this()};
+  if (is_alive() && in_range(origin.get_location(), get_location(), range)) {
+    return this;
   }
-  return {};
+  return nullptr;
 }
 
 // return a vector of only this object
-shared_ptr<AgentComponent> AgentIndividual::get_all_in_range(shared_ptr<const Sim_object> origin,
+shared_ptr<AgentComponent> AgentIndividual::get_all_in_range(const Sim_object& origin,
                                                              double range)
 {
-  auto dist = cartesian_distance(origin->get_location(), get_location());
-  if (dist <= range) {
+  auto dist = cartesian_distance(origin.get_location(), get_location());
+  if (is_alive() && dist <= range) {
     return {shared_from_this()};
   }
   return {};
@@ -84,9 +78,9 @@ void AgentIndividual::move_to(Point destination_)
   start_moving(destination_);
   
   if (is_currently_moving()) {
-    cout << get_name() << ": I'm on the way" << endl;
+    Model::get().out() << get_name() << ": I'm on the way" << endl;
   } else {
-    cout << get_name() << ": I'm already there" << endl;
+    Model::get().out() << get_name() << ": I'm already there" << endl;
   }
 }
 
@@ -95,47 +89,88 @@ void AgentIndividual::stop()
 {
   if (is_currently_moving()) {
     stop_moving();
-    cout << get_name() << ": I'm stopped" << endl;
+    Model::get().out() << get_name() << ": I'm stopped" << endl;
   }
 }
 
 // Tell this AgentIndividual to accept a hit from an attack of a specified strength
-// The attacking AgentIndividual identifies itself with its this pointer.
+// The attacking AgentIndividual identifies itself with *this.
 // A derived class can override this function.
 // The function lose_health is called to handle the effect of the attack.
-void AgentIndividual::take_hit(int attack_strength, shared_ptr<AgentIndividual>attacker_ptr)
+void AgentIndividual::take_hit(int attack_strength, AgentIndividual& attacker)
+{
+  lose_health(attack_strength);
+}
+
+// take a hit from an attacker in another Model
+void AgentIndividual::take_remote_hit(int attack_strength)
 {
   lose_health(attack_strength);
 }
 
+// for copying an agent into another Model
+void AgentIndividual::set_health(int health_)
+{
+  health = health_;
+  alive = health > 0;
+}
+
+// start moving to the destination without comment
+void AgentIndividual::head_to(Point destination_)
+{
+  start_moving(destination_);
+}
+
 // update the moving state and AgentIndividual state of this object.
 void AgentIndividual::update()
 {
   if (is_alive() && is_currently_moving()) {
     if (update_location()) {
       // We've reached our destination.
-      cout << get_name() << ": I'm there!" << endl;
+      Model::get().out() << get_name() << ": I'm there!" << endl;
     } else {
       // We're still moving.
-      cout << get_name() << ": step..." << endl;
+      Model::get().out() << get_name() << ": step..." << endl;
     }
     Model::get().notify_location(get_name(), get_location());
   }
 }
 
+// move for that many ticks at once, reporting and notifying only once
+void AgentIndividual::update_coarse(int ticks)
+{
+  move_for(ticks);
+}
+
+// if moving, take up to that many steps at once and report where we got to
+int AgentIndividual::move_for(int ticks)
+{
+  if (!is_alive() || !is_currently_moving()) {
+    return 0;
+  }
+  int steps = update_location(ticks);
+  if (is_currently_moving()) {
+    Model::get().out() << get_name() << ": step..." << endl;
+  } else {
+    Model::get().out() << get_name() << ": I'm there!" << endl;
+  }
+  Model::get().notify_location(get_name(), get_location());
+  return steps;
+}
+
 // output information about the current state
 void AgentIndividual::describe() const
 {
-  cout << get_name() << " at " << get_location() << endl;
+  Model::get().out() << get_name() << " at " << get_location() << endl;
   if (is_alive()) {
-    cout << "   Health is " << health << endl;
+    Model::get().out() << "   Health is " << health << endl;
     if (is_currently_moving()) {
-      cout << "   Moving at speed " << get_current_speed() << " to " << get_current_destination() << endl;
+      Model::get().out() << "   Moving at speed " << get_current_speed() << " to " << get_current_destination() << endl;
     } else {
-      cout << "   Stopped" << endl;
+      Model::get().out() << "   Stopped" << endl;
     }
   } else {
-    cout << "   Is dead" << endl;
+    Model::get().out() << "   Is dead" << endl;
   }
 }
 
@@ -154,7 +189,7 @@ void AgentIndividual::start_working(shared_ptr<Structure>, shared_ptr<Structure>
 }
 
 // Throws exception that an AgentIndividual cannot attack.
-void AgentIndividual::start_attacking(shared_ptr<AgentComponent>)
+void AgentIndividual::start_attacking(const shared_ptr<AgentComponent>&)
 {
   throw Error( get_name() + ": Sorry, I can't attack!" );
 }
@@ -167,11 +202,11 @@ void AgentIndividual::lose_health(int attack_strength)
   if (health <= 0) {
     alive = false;
     Model::get().notify_gone(get_name());
-    cout << get_name() << ": Arrggh!" << endl;
+    Model::get().out() << get_name() << ": Arrggh!" << endl;
     Model::get().remove_agent(get_name());
   } else {
     Model::get().notify_health(get_name(), health);
-    cout << get_name() << ": Ouch!" << endl;
+    Model::get().out() << get_name() << ": Ouch!" << endl;
   }
 }
 
@@ -181,7 +216,7 @@ void AgentIndividual::gain_health(int blessing_strength)
   if (health == INITIAL_HEALTH) {
     return;
   } else {
-    cout << get_name() << ": I am healed!" << endl;
+    Model::get().out() << get_name() << ": I am healed!" << endl;
     health += blessing_strength;
     
     // If we've gone over our initial health, reset it.
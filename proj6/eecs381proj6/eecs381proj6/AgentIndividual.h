@@ -21,9 +21,12 @@
 class Structure;
 struct Point;
 
+// Moving_object comes last and alive before health, so that alive and health fill
+// the padding after Moving_object's last member and the state every tick updates
+// stays within 64 bytes.
 class AgentIndividual :
-  public AgentComponent, public Sim_object, public Moving_object,
-  public std::enable_shared_from_this<AgentIndividual> {
+  public AgentComponent, public Sim_object,
+  public std::enable_shared_from_this<AgentIndividual>, public Moving_object {
     
 public:
 	
@@ -36,19 +39,25 @@ public:
   const std::string &get_name() const override
     { return Sim_object::get_name(); }
 
-  // does this individual have this prefix?
-  bool has_prefix(const std::string& prefix) override;
-
-  // get shared_from_this
-  std::shared_ptr<AgentIndividual> get_nearest_in_range(std::shared_ptr<const Sim_object> origin,
-                                                        double range) override;
+  // this agent, if it is in range
+  AgentIndividual* get_nearest_in_range(const Sim_object& origin, double range) override;
 
   // return a vector of only this object
-  std::shared_ptr<AgentComponent> get_all_in_range(std::shared_ptr<const Sim_object> origin,
+  std::shared_ptr<AgentComponent> get_all_in_range(const Sim_object& origin,
                                                    double range) override;
   
 	// return true if this agent is Alive
-	bool is_alive() const { return alive; }
+	bool is_alive() const override { return alive; }
+  
+  // the type name that create_agent knows this kind of agent by
+  virtual std::string get_type() const = 0;
+  
+  // health, and setting it, for copying an agent into another Model
+  int get_health() const { return health; }
+  void set_health(int health_);
+  
+  // start moving to the destination without comment, as for a loaded or copied agent
+  void head_to(Point destination_);
 	
 	// return this AgentIndividual's location
 	Point get_location() const override;
@@ -63,10 +72,13 @@ public:
 	void stop() override;
   
 	// Tell this AgentIndividual to accept a hit from an attack of a specified strength
-	// The attacking AgentIndividual identifies itself with its this pointer.
+	// The attacking AgentIndividual identifies itself with *this.
 	// A derived class can override this function.
 	// The function lose_health is called to handle the effect of the attack.
-	virtual void take_hit(int attack_strength, std::shared_ptr<AgentIndividual> attacker_ptr);
+	virtual void take_hit(int attack_strength, AgentIndividual& attacker);
+  
+  // take a hit from an attacker in another Model, which can't be struck back or fled from
+  void take_remote_hit(int attack_strength);
 
   // Tell this AgentIndividual to accept a blessing.
   // Subclasses may override, default implmentation is to do nothing.
@@ -75,6 +87,13 @@ public:
 
 	// update the moving state and AgentIndividual state of this object.
 	void update() override;
+  
+  // live agents can be put on a coarse schedule
+  bool can_coarsen() const override
+    { return is_alive(); }
+  
+  // move for that many ticks at once, reporting and notifying only once
+  void update_coarse(int ticks) override;
 	
 	// output information about the current state
 	void describe() const override;
@@ -86,12 +105,16 @@ public:
 	void start_working(std::shared_ptr<Structure>, std::shared_ptr<Structure>) override;
   
 	// Throws exception that an AgentIndividual cannot attack.
-	void start_attacking(std::shared_ptr<AgentComponent>) override;
+	void start_attacking(const std::shared_ptr<AgentComponent>&) override;
 
   // If we are the named component, return ourselves, otherwise nullptr.
   std::shared_ptr<AgentComponent> get_component(const std::string& name_) override;
 
 protected:
+  // if moving, take up to that many steps at once and report where we got to;
+  // returns the number of ticks spent moving, 0 if not moving
+  int move_for(int ticks);
+  
 	// calculate loss of health due to hit.
 	// if health decreases to zero or negative, AgentIndividual state becomes Dying, and any movement is stopped.
 	void lose_health(int attack_strength);
@@ -102,8 +125,8 @@ protected:
   
 private:
   
-  int health;
   bool alive;
+  int health;
 };
 
 
@@ -0,0 +1,19 @@
+#ifndef AGENT_HANDLE_H_
+#define AGENT_HANDLE_H_
+
+/* An Agent_handle refers to an agent component in the Model's agent table without
+ owning it. The Model moves a slot to a new generation when its component leaves,
+ so a stale handle is caught by comparing generations instead of by reference counting.
+ A default handle never refers to anything. */
+
+struct Agent_handle {
+  Agent_handle() :
+    index{-1}, generation{0} {}
+  Agent_handle(int index_, unsigned generation_) :
+    index{index_}, generation{generation_} {}
+  
+  int index;
+  unsigned generation;
+};
+
+#endif
@@ -10,7 +10,7 @@
 
 using std::vector;
 using std::string;
-using std::cout; using std::endl;
+using std::endl;
 using std::shared_ptr;
 
 const int ARCHER_ATTACK_STRENGTH = 1;
@@ -25,9 +25,9 @@ void Archer::update()
   Warrior::update();
   
   // If we aren't attacking, look for someone to shoot!
-  if (!is_attacking()) {
+  if (is_alive() && !is_attacking()) {
     auto closest_agent =
-        Model::get().closest_agent_in_range_not_in_group(shared_from_this(), get_attack_range());
+        Model::get().closest_agent_in_range_not_in_group(*this, get_attack_range());
     
     // Validate closest_agent. If he's not nullptr, then he is in range.
     if (closest_agent) {
@@ -36,24 +36,24 @@ void Archer::update()
   }
 }
 
-void Archer::take_hit(int attack_strength, shared_ptr<AgentIndividual> attacker_ptr)
+void Archer::take_hit(int attack_strength, AgentIndividual& attacker)
 {
-  AgentIndividual::take_hit(attack_strength, attacker_ptr);
+  AgentIndividual::take_hit(attack_strength, attacker);
   
-  if (is_alive() && attacker_ptr->is_alive()) {
+  if (is_alive() && attacker.is_alive()) {
     // Run away!
-    auto closest_structure = Model::get().closest_structure(shared_from_this());
+    auto closest_structure = Model::get().closest_structure(*this);
     if (!closest_structure) {
       return;
     }
-    cout << get_name() << ": I'm going to run away to " << closest_structure->get_name() << endl;
+    Model::get().out() << get_name() << ": I'm going to run away to " << closest_structure->get_name() << endl;
     move_to(closest_structure->get_location());
   }
 }
 
 void Archer::describe() const
 {
-  cout << "Archer ";
+  Model::get().out() << "Archer ";
   Warrior::describe();
 }
 
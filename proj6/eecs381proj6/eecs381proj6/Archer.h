@@ -25,12 +25,15 @@ public:
   void update() override;
   
   // Overrides AgentComponent's take_hit to run away to the nearest Structure when attacked.
-  void take_hit(int attack_strength, std::shared_ptr<AgentIndividual> attacker) override;
+  void take_hit(int attack_strength, AgentIndividual& attacker) override;
   
   // output information specific to Archer
   void describe() const override;
   
   std::string get_battle_cry() override;
+  
+  std::string get_type() const override
+    { return "Archer"; }
 };
 
 #endif
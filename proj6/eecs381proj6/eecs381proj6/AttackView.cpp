@@ -2,98 +2,248 @@
 #include "AttackView.h"
 
 #include "Geometry.h"
+#include "Utility.h"
 
+#include <algorithm>
 #include <iostream>
-#include <set>
 
 using std::cout; using std::endl;
 using std::string;
-using std::set;
+using std::vector;
+using std::min;
+using std::partial_sort;
 
 // number of dots per unit of distance
 const int DISTANCE_MULT = 3;
 const string DOT = ". ";
+// longer distances are cut to this many dots and the elided marker
+const int MAX_DOTS = 30;
+const string ELIDED_DOTS = "... ";
 const string ATTACK_SYMBOL_LEFT = " > ";
 const string ATTACK_SYMBOL_RIGHT = "< ";
+const int NO_TARGET = -1;
 
 // a new attack has started, keep track of it
 void AttackView::update_attack(const std::string& name, const std::string& target)
 {
-  attackers[name] = target;
+  // End any earlier attack first, so its target can't be released out from under us.
+  int attacker_id = get_id(name);
+  end_attack(attacker_id);
+  
+  int target_id = get_id(target);
+  nodes[attacker_id].target = target_id;
+  ++nodes[target_id].attacked_by;
+  duels[name] = attacker_id;
 }
 
 // an attack has ended, remove it
 void AttackView::update_end_attack(const std::string& name)
 {
-  attackers.erase(name);
+  auto itr = ids.find(name);
+  if (itr != ids.end()) {
+    end_attack(itr->second);
+    release(itr->second);
+  }
 }
 
 // an agent involved in an attack has lost health
 void AttackView::update_health(const std::string& name, int health)
 {
-  healths[name] = health;
+  Node &node = nodes[get_id(name)];
+  node.health = health;
+  node.present = true;
 }
 
 // an agent involved in an attack has moved
 void AttackView::update_location(const std::string &name, Point location)
 {
-  locations[name] = location;
+  Node &node = nodes[get_id(name)];
+  node.location = location;
+  node.present = true;
 }
 
 // Notify for removal of object
 void AttackView::update_remove(const std::string& name)
 {
-  attackers.erase(name);
-  healths.erase(name);
-  locations.erase(name);
+  auto itr = ids.find(name);
+  if (itr == ids.end()) {
+    return;
+  }
+  int id = itr->second;
+  end_attack(id);
+  
+  // Anyone still attacking it sees a blank health and location until they stop.
+  Node &node = nodes[id];
+  node.health = 0;
+  node.location = Point();
+  node.present = false;
+  release(id);
 }
 
 // prints out the view
 void AttackView::draw()
 {
-  if (!attackers.size()) {
+  if (!duels.size()) {
     cout << "No Active Duels!" << endl;
     return;
   }
   
+  vector<int> printable = collect_duels();
+  
+  if (mode == SUMMARY) {
+    int mutual = static_cast<int>(duels.size() - printable.size());
+    cout << "Current Duels: " << printable.size() << " (" << mutual << " mutual)" << endl;
+    return;
+  }
+  
   cout << "Current Duels:" << endl;
-  set<string> printed;
   
-  for (auto &pair : attackers) {
-    auto &attacker = pair.first;
-    auto &target = pair.second;
-    auto a_health = healths[attacker];
-    auto t_health = healths[target];
-    
-    // we already printed the other side of this duel
-    if (printed.find(attacker) != printed.end()) continue;
-    
-    // get the truncated distance between the duel
-    int dist = cartesian_distance(locations[attacker], locations[target]) * DISTANCE_MULT;
-    
-    cout << "(" << a_health << ") " << attacker << ATTACK_SYMBOL_LEFT;
-    
-    // print dots to represent distance in 2d
-    for (int i = 0; i < dist; ++i) {
-      cout << DOT;
-    }
-    
-    auto target_itr = attackers.find(target);
-    // check if our target is attacking us back
-    if (target_itr != attackers.end() && target_itr->second == attacker) {
-      // remember the attacking targets we've already printed
-      printed.insert(target_itr->first);
-      cout << ATTACK_SYMBOL_RIGHT;
+  if (mode == ALL || top_k >= static_cast<int>(printable.size())) {
+    for (int attacker_id : printable) {
+      print_duel(attacker_id);
     }
-    cout << target << " (" << t_health << ")"  << endl;
-    
+    return;
+  }
+  
+  // The most critical duels are those whose weakest participant has the lowest health.
+  auto weakest = [this](int attacker_id) {
+    const Node &attacker = nodes[attacker_id];
+    return min(attacker.health, nodes[attacker.target].health);
+  };
+  partial_sort(printable.begin(), printable.begin() + top_k, printable.end(),
+               [&](int a, int b) {
+                 int weakest_a = weakest(a), weakest_b = weakest(b);
+                 if (weakest_a != weakest_b) {
+                   return weakest_a < weakest_b;
+                 }
+                 return nodes[a].name < nodes[b].name;
+               });
+  for (int i = 0; i < top_k; ++i) {
+    print_duel(printable[i]);
   }
+  cout << "... and " << printable.size() - top_k << " more" << endl;
 }
 
 // discards the view's contents
 void AttackView::clear()
 {
-  attackers.clear();
-  healths.clear();
-  locations.clear();
+  ids.clear();
+  nodes.clear();
+  free_ids.clear();
+  duels.clear();
+}
+
+// show every duel, the default
+void AttackView::show_all()
+{
+  mode = ALL;
+}
+
+// show only the k most critical duels, throws if k is not positive
+void AttackView::show_top(int k)
+{
+  if (k <= 0) {
+    throw Error("Number of duels must be positive!");
+  }
+  mode = TOP;
+  top_k = k;
+}
+
+// show only the number of duels
+void AttackView::show_summary()
+{
+  mode = SUMMARY;
+}
+
+// get the id for the name, creating a node if there isn't one
+int AttackView::get_id(const string& name)
+{
+  auto itr = ids.find(name);
+  if (itr != ids.end()) {
+    return itr->second;
+  }
+  
+  int id;
+  if (free_ids.empty()) {
+    id = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+  } else {
+    id = free_ids.back();
+    free_ids.pop_back();
+    nodes[id] = Node();
+  }
+  nodes[id].name = name;
+  nodes[id].target = NO_TARGET;
+  ids[name] = id;
+  return id;
+}
+
+// stop the node from attacking, if it is
+void AttackView::end_attack(int id)
+{
+  int target_id = nodes[id].target;
+  if (target_id == NO_TARGET) {
+    return;
+  }
+  nodes[id].target = NO_TARGET;
+  --nodes[target_id].attacked_by;
+  duels.erase(nodes[id].name);
+  release(target_id);
+}
+
+// reuse the node's slot if it is gone and no duel refers to it
+void AttackView::release(int id)
+{
+  Node &node = nodes[id];
+  if (node.present || node.attacked_by || node.target != NO_TARGET) {
+    return;
+  }
+  ids.erase(node.name);
+  node.name.clear();
+  free_ids.push_back(id);
+}
+
+// the ids of the duels to print, one per mutual pair, in attacker name order
+vector<int> AttackView::collect_duels() const
+{
+  vector<int> printable;
+  printable.reserve(duels.size());
+  for (auto &pair : duels) {
+    const Node &attacker = nodes[pair.second];
+    const Node &target = nodes[attacker.target];
+    
+    // a mutual duel is printed once, by whichever side comes first by name
+    if (target.target == pair.second && target.name < attacker.name) continue;
+    printable.push_back(pair.second);
+  }
+  return printable;
+}
+
+// print one duel line for the given attacker
+void AttackView::print_duel(int attacker_id)
+{
+  const Node &attacker = nodes[attacker_id];
+  const Node &target = nodes[attacker.target];
+  
+  // get the truncated distance between the duel
+  int dist = cartesian_distance(attacker.location, target.location) * DISTANCE_MULT;
+  
+  cout << "(" << attacker.health << ") " << attacker.name << ATTACK_SYMBOL_LEFT;
+  
+  // print dots to represent distance in 2d
+  if (dots.empty()) {
+    for (int i = 0; i < MAX_DOTS; ++i) {
+      dots += DOT;
+    }
+  }
+  cout.write(dots.data(), min(dist, MAX_DOTS) * DOT.size());
+  if (dist > MAX_DOTS) {
+    cout << ELIDED_DOTS;
+  }
+  
+  // check if our target is attacking us back
+  if (target.target == attacker_id) {
+    cout << ATTACK_SYMBOL_RIGHT;
+  }
+  cout << target.name << " (" << target.health << ")"  << endl;
 }
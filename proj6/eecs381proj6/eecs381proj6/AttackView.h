@@ -9,12 +9,21 @@
  each agent the health and name will be displayed. The 
  distance between the agents is shown as well.
  
+ Every named object gets an id into a table of nodes, and each
+ node holds the id of the node it is attacking, so the duel graph
+ is kept up to date as updates come in and a reciprocal attack is
+ found with a single lookup. The view can show every duel, only the
+ top K most critical duels (lowest health first), or just a summary.
+ 
 */
 
 #include "View.h"
+#include "Geometry.h"
 
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 class AttackView : public View {
 public:
@@ -40,16 +49,55 @@ public:
 	// discards the view's contents
 	void clear() override;
   
-protected:
-  using Attckers_t = std::map<std::string, std::string>;
-  using Healths_t = std::map<std::string, int>;
-  using Locations_t = std::map<std::string, Point>;
+  // show every duel, the default
+  void show_all();
+  // show only the k most critical duels, throws if k is not positive
+  void show_top(int k);
+  // show only the number of duels
+  void show_summary();
   
 private:
+  using Draw_mode_e = enum {
+    ALL,
+    TOP,
+    SUMMARY
+  };
+  
+  // everything we know about one named object
+  struct Node {
+    std::string name;
+    int health = 0;
+    Point location;
+    int target;          // id of the node being attacked, or NO_TARGET
+    int attacked_by = 0; // number of nodes attacking this one
+    bool present = true; // false once the object is gone
+  };
+  
+  using Ids_t = std::unordered_map<std::string, int>;
+  using Nodes_t = std::vector<Node>;
+  using Duels_t = std::map<std::string, int>;
+  
+  // get the id for the name, creating a node if there isn't one
+  int get_id(const std::string& name);
+  // stop the node from attacking, if it is
+  void end_attack(int id);
+  // reuse the node's slot if it is gone and no duel refers to it
+  void release(int id);
+  
+  // the ids of the duels to print, one per mutual pair, in attacker name order
+  std::vector<int> collect_duels() const;
+  // print one duel line for the given attacker
+  void print_duel(int attacker_id);
+  
+  Ids_t ids;
+  Nodes_t nodes;
+  std::vector<int> free_ids;
+  Duels_t duels;      // attacker name to attacker id, for printing in name order
+  
+  Draw_mode_e mode = ALL;
+  int top_k = 0;
   
-  Attckers_t attackers;
-  Healths_t healths;
-  Locations_t locations;
+  std::string dots;   // preformatted distance dots, made on first use
 };
 
 #endif
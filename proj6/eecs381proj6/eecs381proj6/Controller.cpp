@@ -13,16 +13,21 @@
 #include "LocalMapView.h"
 #include "MapView.h"
 #include "Model.h"
+#include "Scenario_loader.h"
+#include "Shard_runner.h"
 #include "Sim_object.h"
 #include "Structure.h"
 #include "Structure_factory.h"
+#include "Trial_runner.h"
 #include "Utility.h"
 #include "View.h"
 
 #include <algorithm>
 #include <cassert>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 using std::bad_alloc;
 using std::cout; using std::cin; using std::endl;
@@ -30,85 +35,112 @@ using std::string; using std::all_of;
 using std::shared_ptr;
 using std::make_shared;
 using std::find_if;
+using std::ifstream; using std::ostringstream;
 
-// simple helper functions
-void bad_command();
-int read_int();
-double read_double();
-Point read_point();
-string read_object_name();
+using std::map;
+using std::ios;
 
-// init control function maps
-Controller::Controller()
+// init control function tables
+Controller::Controller() :
+  input(cin)
 {
-  view_mgmt_cmds["open"]    = &Controller::view_open;
-  view_mgmt_cmds["close"]   = &Controller::view_close;
+  map<string, CmdFunc_t> cmds;
+  cmds["open"]      = &Controller::view_open;
+  cmds["close"]     = &Controller::view_close;
   
-  map_view_cmds["default"]  = &Controller::view_default;
-  map_view_cmds["size"]     = &Controller::view_size;
-  map_view_cmds["zoom"]     = &Controller::view_zoom;
-  map_view_cmds["pan"]      = &Controller::view_pan;
+  cmds["default"]   = map_view_cmd(&Controller::view_default);
+  cmds["size"]      = map_view_cmd(&Controller::view_size);
+  cmds["zoom"]      = map_view_cmd(&Controller::view_zoom);
+  cmds["pan"]       = map_view_cmd(&Controller::view_pan);
   
-  program_cmds["status"]    = &Controller::prog_status;
-  program_cmds["show"]      = &Controller::prog_show;
-  program_cmds["go"]        = &Controller::prog_go;
-  program_cmds["build"]     = &Controller::prog_build;
-  program_cmds["train"]     = &Controller::prog_train;
-  
-  agent_cmds["move"]        = &Controller::agent_move;
-  agent_cmds["work"]        = &Controller::agent_work;
-  agent_cmds["attack"]      = &Controller::agent_attack;
-  agent_cmds["stop"]        = &Controller::agent_stop;
+  cmds["status"]    = &Controller::prog_status;
+  cmds["show"]      = &Controller::prog_show;
+  cmds["go"]        = &Controller::prog_go;
+  cmds["build"]     = &Controller::prog_build;
+  cmds["train"]     = &Controller::prog_train;
+  cmds["load"]      = &Controller::prog_load;
+  cmds["lod"]       = &Controller::prog_lod;
+  cmds["shard"]     = &Controller::prog_shard;
+  cmds["trials"]    = &Controller::prog_trials;
   
   // add new group commands
-  program_cmds["group"]     = &Controller::group_create;
-  program_cmds["disband"]   = &Controller::group_disband;
-  agent_cmds["add"]         = &Controller::group_add;
-  agent_cmds["remove"]      = &Controller::group_remove;
-
+  cmds["group"]     = &Controller::group_create;
+  cmds["disband"]   = &Controller::group_disband;
+  
+  map<string, CmdFunc_Agent_t> agent_commands;
+  agent_commands["move"]    = &Controller::agent_move;
+  agent_commands["work"]    = &Controller::agent_work;
+  agent_commands["attack"]  = &Controller::agent_attack;
+  agent_commands["stop"]    = &Controller::agent_stop;
+  agent_commands["add"]     = &Controller::group_add;
+  agent_commands["remove"]  = &Controller::group_remove;
+  
+  // these follow the view's name, as in map ansi or attack top 5
+  map<string, CmdFunc_t> map_commands;
+  map_commands["ansi"]      = map_view_cmd(&Controller::view_ansi);
+  map_commands["plain"]     = map_view_cmd(&Controller::view_plain);
+  
+  map<string, CmdFunc_t> attack_commands;
+  attack_commands["all"]     = attack_view_cmd(&Controller::view_all);
+  attack_commands["top"]     = attack_view_cmd(&Controller::view_top);
+  attack_commands["summary"] = attack_view_cmd(&Controller::view_summary);
+  
+  commands = Perfect_hash_map<CmdFunc_t>(cmds);
+  agent_cmds = Perfect_hash_map<CmdFunc_Agent_t>(agent_commands);
+  map_view_cmds = Perfect_hash_map<CmdFunc_t>(map_commands);
+  attack_view_cmds = Perfect_hash_map<CmdFunc_t>(attack_commands);
 }
 
 // create View object, run the program
 void Controller::run()
 {
+  // All of our I/O goes through cin and cout, so they needn't keep in step with stdio.
+  ios::sync_with_stdio(false);
+  
+  string command;
   while (1) {
     try {
-      string command;
       cout << "\nTime " << Model::get().get_time() << ": Enter command: ";
-      cin >> command;
+      if (!input.read_word(command)) {
+        break;
+      }
       
       if (command == "quit") {
         cout << "Done" << endl;
         break;
       }
       
-      CmdFunc_t::iterator program_cmd;
-      CmdFunc_t::iterator view_mgmt_cmd;
-      CmdFunc_Map_View_t::iterator map_view_cmd;
-      CmdFunc_t::iterator group_mgmt_cmd;
+      // Everything but go looks at or changes the current state, so agents on the
+      // coarse schedule have to catch up first.
+      if (command != "go") {
+        Model::get().synchronize();
+      }
       
-      // Call the correct function based on the command word.
-      if (Model::get().is_agent_component_present(command)) {
+      // Command words come first, so only a word that isn't one is looked up as a name.
+      if (const CmdFunc_t* program_cmd = commands.find(command)) {
+        (*program_cmd)(this);
+      } else if (Model::get().is_agent_component_present(command)) {
         shared_ptr<AgentComponent> agent = Model::get().get_agent_comp_ptr(command);
         
         // Check that the agent command is valid.
-        cin >> command;
-        auto agent_command = agent_cmds.find(command);
-        if (agent_command == agent_cmds.end()) {
+        input.read_word(command);
+        const CmdFunc_Agent_t* agent_command = agent_cmds.find(command);
+        if (!agent_command) {
           throw Error("Unrecognized command!");
         }
         
-        agent_command->second(this, agent);
-      } else if ((program_cmd = program_cmds.find(command)) != program_cmds.end()) {
-        program_cmd->second(this);
-      } else if ((view_mgmt_cmd = view_mgmt_cmds.find(command)) != view_mgmt_cmds.end()) {
-        view_mgmt_cmd->second(this);
-      } else if ((map_view_cmd = map_view_cmds.find(command)) != map_view_cmds.end()) {
-        auto map = map_view.lock();
-        if (!map) {
-          throw Error("No map view is open!");
+        (*agent_command)(this, agent);
+      } else if (command == "map" || command == "attack") {
+        // Commands for one kind of view come after its name, so they aren't reserved.
+        const Perfect_hash_map<CmdFunc_t>& view_cmds =
+            command == "map" ? map_view_cmds : attack_view_cmds;
+        input.read_word(command);
+        const CmdFunc_t* view_command = view_cmds.find(command);
+        if (!view_command) {
+          throw Error("Unrecognized command!");
         }
-        map_view_cmd->second(this, map);
+        
+        (*view_command)(this);
       } else {
         throw Error("Unrecognized command!");
       }
@@ -116,8 +148,7 @@ void Controller::run()
     } catch (Error &e) {
       cout << e.msg << endl;
       // clear line
-      cin.clear();
-      while(cin.get() != '\n');
+      input.skip_line();
     } catch (bad_alloc &a) {
       cout << "Bad allocation" << endl;
       break;
@@ -128,12 +159,33 @@ void Controller::run()
   }
 }
 
+Controller::CmdFunc_t Controller::map_view_cmd(Map_view_cmd_t cmd)
+{
+  return [cmd](Controller* controller) {
+    auto map = controller->map_view.lock();
+    if (!map) {
+      throw Error("No map view is open!");
+    }
+    (controller->*cmd)(map);
+  };
+}
+
+Controller::CmdFunc_t Controller::attack_view_cmd(Attack_view_cmd_t cmd)
+{
+  return [cmd](Controller* controller) {
+    auto attack = controller->attack_view.lock();
+    if (!attack) {
+      throw Error("No attack view is open!");
+    }
+    (controller->*cmd)(attack);
+  };
+}
+
 // view commands //
 
 void Controller::view_open()
 {
-  string name;
-  cin >> name;
+  string name = read_word();
   
   // Check to see if view already exists.
   auto open_view_itr =
@@ -150,8 +202,7 @@ void Controller::view_open()
 
 void Controller::view_close()
 {
-  string name;
-  cin >> name;
+  string name = read_word();
   
   // Check that the view is open.
   auto open_view_itr =
@@ -181,6 +232,27 @@ void Controller::view_pan(std::shared_ptr<FullMapView> map)
 {
   map->set_origin(read_point());
 }
+void Controller::view_ansi(std::shared_ptr<FullMapView> map)
+{
+  map->set_ansi_mode(true);
+}
+void Controller::view_plain(std::shared_ptr<FullMapView> map)
+{
+  map->set_ansi_mode(false);
+}
+
+void Controller::view_all(std::shared_ptr<AttackView> attack)
+{
+  attack->show_all();
+}
+void Controller::view_top(std::shared_ptr<AttackView> attack)
+{
+  attack->show_top(read_int());
+}
+void Controller::view_summary(std::shared_ptr<AttackView> attack)
+{
+  attack->show_summary();
+}
 
 // view factory
 shared_ptr<View> Controller::create_view(const string& name)
@@ -195,7 +267,9 @@ shared_ptr<View> Controller::create_view(const string& name)
   } else if (name == "amounts") {
     view = make_shared<AmountsView>();
   } else if (name == "attack") {
-    view = make_shared<AttackView>();
+    auto new_view = make_shared<AttackView>();
+    attack_view = new_view;
+    view = new_view;
   } else if (Model::get().object_fullname_exists(name)) {
     view = make_shared<LocalMapView>(name);
   } else {
@@ -224,8 +298,7 @@ void Controller::prog_build()
 {
   // read in a valid name and type
   string name = read_object_name();
-  string type;
-  cin >> type;
+  string type = read_word();
   
   // create/add the structure to the model
   shared_ptr<Structure>s = create_structure(name, type, read_point());
@@ -236,14 +309,50 @@ void Controller::prog_train()
 {
   // read in a valid name and type
   string name = read_object_name();
-  string type;
-  cin >> type;
+  string type = read_word();
   
   // create/add the agent to the model
   shared_ptr<AgentIndividual> agent = create_agent(name, type, read_point());
   Model::get().add_new_agent(agent);
 }
 
+void Controller::prog_load()
+{
+  string filename = read_word();
+  ifstream scenario(filename);
+  if (!scenario) {
+    throw Error("Could not open scenario file!");
+  }
+  
+  int count = load_scenario(scenario);
+  cout << "Loaded " << count << " objects" << endl;
+}
+
+void Controller::prog_lod()
+{
+  Model::get().set_lod_interval(read_int());
+}
+
+void Controller::prog_shard()
+{
+  int regions = read_int();
+  run_shards(regions, read_int());
+}
+
+void Controller::prog_trials()
+{
+  int count = read_int();
+  int ticks = read_int();
+  string filename = read_word();
+  ifstream scenario(filename);
+  if (!scenario) {
+    throw Error("Could not open scenario file!");
+  }
+  ostringstream text;
+  text << scenario.rdbuf();
+  run_trials(text.str(), count, ticks);
+}
+
 // agent commands //
 
 void Controller::agent_move(shared_ptr<AgentComponent> agent)
@@ -252,16 +361,15 @@ void Controller::agent_move(shared_ptr<AgentComponent> agent)
 }
 void Controller::agent_work(shared_ptr<AgentComponent> agent)
 {
-  string source, destination;
-  cin >> source >> destination;
+  string source = read_word();
+  string destination = read_word();
   shared_ptr<Structure> src = Model::get().get_structure_ptr(source);
   shared_ptr<Structure> dest = Model::get().get_structure_ptr(destination);
   agent->start_working(src, dest);
 }
 void Controller::agent_attack(shared_ptr<AgentComponent> attacker)
 {
-  string agent_name;
-  cin >> agent_name;
+  string agent_name = read_word();
 
   auto target = Model::get().get_agent_comp_ptr(agent_name);  
   attacker->start_attacking(target);
@@ -275,15 +383,16 @@ void Controller::agent_stop(shared_ptr<AgentComponent> agent)
 
 void Controller::group_create()
 {
-  string group_name;
-  cin >> group_name;
+  string group_name = read_word();
+  if (is_reserved_word(group_name)) {
+    throw Error("Invalid name for new object!");
+  }
   Model::get().add_new_agent_component(make_shared<AgentGroup>(group_name));
 }
 
 void Controller::group_disband()
 {
-  string group_name;
-  cin >> group_name;
+  string group_name = read_word();
   
   // remove the group from the model
   Model::get().remove_agent_component(group_name);
@@ -291,8 +400,7 @@ void Controller::group_disband()
 
 void Controller::group_add(std::shared_ptr<AgentComponent> group)
 {
-  string agent_name;
-  cin >> agent_name;
+  string agent_name = read_word();
   
   // Get the agent component and call Model to handle insertion
   shared_ptr<AgentComponent> component = Model::get().get_agent_comp_ptr(agent_name);
@@ -301,8 +409,7 @@ void Controller::group_add(std::shared_ptr<AgentComponent> group)
 
 void Controller::group_remove(std::shared_ptr<AgentComponent> group)
 {
-  string agent_name;
-  cin >> agent_name;
+  string agent_name = read_word();
   
   shared_ptr<AgentComponent> component = Model::get().get_agent_comp_ptr(agent_name);
   Model::get().remove_agent_component_from_group(component, group);
@@ -310,44 +417,55 @@ void Controller::group_remove(std::shared_ptr<AgentComponent> group)
 
 // HELPERS //
 
+bool Controller::is_reserved_word(const string& word) const
+{
+  return word == "quit" || commands.find(word) || agent_cmds.find(word);
+}
+
+// read a word, empty if the input has ended
+string Controller::read_word()
+{
+  string word;
+  input.read_word(word);
+  return word;
+}
+
 // read int, error for non-digts
-int read_int()
+int Controller::read_int()
 {
   int num;
-  if (!(cin >> num)) {
+  if (!input.read_int(num)) {
     throw Error("Expected an integer!");
   }
   return num;
 }
 
 // checks valid double
-double read_double()
+double Controller::read_double()
 {
   double num;
-  if (!(cin >> num)) {
+  if (!input.read_double(num)) {
     throw Error("Expected a double!");
   }
   return num;
 }
 
 // read in a point
-Point read_point()
+Point Controller::read_point()
 {
   double x = read_double();
   double y = read_double();
   return {x,y};
 }
 
-// read valid obj name
-string read_object_name()
+// read valid obj name, which can't be a command word or it could never be commanded
+string Controller::read_object_name()
 {
-  string name;
-  cin >> name;
+  string name = read_word();
   bool plain = all_of(name.begin(), name.end(), isalnum);
   bool in_use = Model::get().is_name_in_use(name);
-  if (name.length() < 2 || !plain || in_use) {
+  if (name.length() < 2 || !plain || in_use || is_reserved_word(name)) {
     throw Error("Invalid name for new object!");
   }
   return name;
 }
-
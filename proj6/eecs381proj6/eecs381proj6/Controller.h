@@ -3,17 +3,24 @@
 
 /* Controller
  This class is responsible for controlling the Model and View according to interactions
- with the user.
+ with the user. Command words are looked up in perfect hash tables before agent names,
+ then the commands of the map and attack views after the view's name, and all input is
+ read through a Tokenizer.
  */
 
+#include "Perfect_hash_map.h"
+#include "Tokenizer.h"
+
 #include <functional>
 #include <list>
-#include <map>
 #include <memory>
 #include <string>
 
+struct Point;
+
 class View;
 class FullMapView;
+class AttackView;
 class AgentComponent;
 
 class Controller {
@@ -25,9 +32,10 @@ public:
 	void run();
   
 private:
-  using CmdFunc_t = std::map<std::string, std::function<void(Controller*)>>;
-  using CmdFunc_Agent_t = std::map<std::string, std::function<void(Controller*, std::shared_ptr<AgentComponent>)>>;
-  using CmdFunc_Map_View_t = std::map<std::string, std::function<void(Controller*, std::shared_ptr<FullMapView>)>>;
+  using CmdFunc_t = std::function<void(Controller*)>;
+  using CmdFunc_Agent_t = std::function<void(Controller*, std::shared_ptr<AgentComponent>)>;
+  using Map_view_cmd_t = void (Controller::*)(std::shared_ptr<FullMapView>);
+  using Attack_view_cmd_t = void (Controller::*)(std::shared_ptr<AttackView>);
   
   using viewPair_t = struct {
     std::string name;
@@ -35,6 +43,20 @@ private:
   };
   using Views_t = std::list<viewPair_t>;
   
+  // wrap a map or attack view command so that it first finds the open view
+  static CmdFunc_t map_view_cmd(Map_view_cmd_t cmd);
+  static CmdFunc_t attack_view_cmd(Attack_view_cmd_t cmd);
+  
+  // is this word a command, and so can't be used as the name of a new object?
+  bool is_reserved_word(const std::string& word) const;
+  
+  // input helpers, all throw Error if the input isn't valid
+  std::string read_word();
+  int read_int();
+  double read_double();
+  Point read_point();
+  std::string read_object_name();
+  
   // control view commands
   void view_open();
   void view_close();
@@ -44,6 +66,13 @@ private:
   void view_size(std::shared_ptr<FullMapView> map);
   void view_zoom(std::shared_ptr<FullMapView> map);
   void view_pan(std::shared_ptr<FullMapView> map);
+  void view_ansi(std::shared_ptr<FullMapView> map);
+  void view_plain(std::shared_ptr<FullMapView> map);
+  
+  // attack view commands
+  void view_all(std::shared_ptr<AttackView> attack);
+  void view_top(std::shared_ptr<AttackView> attack);
+  void view_summary(std::shared_ptr<AttackView> attack);
   
   // view factory
   std::shared_ptr<View> create_view(const std::string& name);
@@ -54,6 +83,10 @@ private:
   void prog_go();
   void prog_build();
   void prog_train();
+  void prog_load();
+  void prog_lod();
+  void prog_shard();
+  void prog_trials();
   
   // agent commands
   void agent_move(std::shared_ptr<AgentComponent>);
@@ -70,13 +103,16 @@ private:
   
   // weak pointer to prevent 
   std::weak_ptr<FullMapView> map_view;
+  std::weak_ptr<AttackView> attack_view;
   
   // containers
-  CmdFunc_t program_cmds;
-  CmdFunc_Agent_t agent_cmds;
-  CmdFunc_t view_mgmt_cmds;
-  CmdFunc_Map_View_t map_view_cmds;
+  Perfect_hash_map<CmdFunc_t> commands;
+  Perfect_hash_map<CmdFunc_Agent_t> agent_cmds;
+  Perfect_hash_map<CmdFunc_t> map_view_cmds;
+  Perfect_hash_map<CmdFunc_t> attack_view_cmds;
   Views_t views;
+  
+  Tokenizer input;
 };
 
 #endif
\ No newline at end of file
@@ -6,7 +6,7 @@
 #include <iostream>
 
 using std::string;
-using std::cout; using std::endl;
+using std::endl;
 
 const double INITIAL_FOOD = 50.0;
 const double FOOD_PRODUCED_PER_UPDATE = 2.0;
@@ -32,14 +32,14 @@ void Farm::update()
 {
   food_available += FOOD_PRODUCED_PER_UPDATE;
   Model::get().notify_amount(get_name(), food_available);
-  cout << "Farm " << get_name() << " now has " << food_available << endl;
+  Model::get().out() << "Farm " << get_name() << " now has " << food_available << endl;
 }
 
 void Farm::describe() const
 {
-  cout << "Farm ";
+  Model::get().out() << "Farm ";
   Structure::describe();
-  cout << "   Food available: " << food_available << endl;
+  Model::get().out() << "   Food available: " << food_available << endl;
 }
 
 void Farm::broadcast_current_state()
@@ -20,6 +20,8 @@ public:
 	// and deducts that amount from the amount on hand
 	double withdraw(double amount_to_get) override;
   
+	double get_amount() const override { return food_available; }
+  
 	// update adds the production amount to the stored amount
 	void update() override;
   
@@ -0,0 +1,167 @@
+/*
+ Geometry_kernels.cpp implementation file
+ See Geometry_kernels.h for comments
+ */
+
+#include "Geometry_kernels.h"
+
+#include "Geometry.h"
+
+#include <cmath>
+#include <limits>
+
+// Build with -DSCALAR_GEOMETRY to use the plain loops even where vectors are available.
+#if defined(SCALAR_GEOMETRY)
+#elif defined(__AVX__)
+#define GEOMETRY_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#define GEOMETRY_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+const double NO_DISTANCE = numeric_limits<double>::infinity();
+
+double cartesian_distance_squared(const Point& p1, const Point& p2)
+{
+	double xd = p2.x - p1.x;
+	double yd = p2.y - p1.y;
+	return xd * xd + yd * yd;
+}
+
+void squared_distances(const double* xs, const double* ys, int n, Point p, double* out)
+{
+	int i = 0;
+#if defined(GEOMETRY_AVX)
+	__m256d px = _mm256_set1_pd(p.x), py = _mm256_set1_pd(p.y);
+	for (; i + 4 <= n; i += 4) {
+		__m256d xd = _mm256_sub_pd(_mm256_loadu_pd(xs + i), px);
+		__m256d yd = _mm256_sub_pd(_mm256_loadu_pd(ys + i), py);
+		_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(xd, xd), _mm256_mul_pd(yd, yd)));
+	}
+#elif defined(GEOMETRY_SSE2)
+	__m128d px = _mm_set1_pd(p.x), py = _mm_set1_pd(p.y);
+	for (; i + 2 <= n; i += 2) {
+		__m128d xd = _mm_sub_pd(_mm_loadu_pd(xs + i), px);
+		__m128d yd = _mm_sub_pd(_mm_loadu_pd(ys + i), py);
+		_mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(xd, xd), _mm_mul_pd(yd, yd)));
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = cartesian_distance_squared(p, Point(xs[i], ys[i]));
+	}
+}
+
+#if defined(GEOMETRY_AVX) || defined(GEOMETRY_SSE2)
+// Combine the closest point of each lane into best, taking the lowest index among
+// equally close points.
+void combine_lanes(const double* lane_bests, const double* lane_indexes, int lanes,
+                   double& best, int& best_index)
+{
+	for (int lane = 0; lane < lanes; ++lane) {
+		int lane_best_index = int(lane_indexes[lane]);
+		if (lane_best_index < 0) {
+			continue;
+		}
+		if (lane_bests[lane] < best || (lane_bests[lane] == best && lane_best_index < best_index)) {
+			best = lane_bests[lane];
+			best_index = lane_best_index;
+		}
+	}
+}
+#endif
+
+int min_distance_index(const double* xs, const double* ys, int n, Point p, int skip)
+{
+	int best_index = -1;
+	double best = NO_DISTANCE;
+	int i = 0;
+	
+	// Each lane keeps its own closest point; strict comparisons keep the earliest on a tie.
+#if defined(GEOMETRY_AVX)
+	const int lanes = 4;
+	__m256d px = _mm256_set1_pd(p.x), py = _mm256_set1_pd(p.y);
+	__m256d skip_index = _mm256_set1_pd(skip);
+	__m256d index = _mm256_set_pd(3., 2., 1., 0.), step = _mm256_set1_pd(lanes);
+	__m256d lane_best = _mm256_set1_pd(NO_DISTANCE), lane_index = _mm256_set1_pd(-1.);
+	for (; i + lanes <= n; i += lanes) {
+		__m256d xd = _mm256_sub_pd(_mm256_loadu_pd(xs + i), px);
+		__m256d yd = _mm256_sub_pd(_mm256_loadu_pd(ys + i), py);
+		__m256d d = _mm256_add_pd(_mm256_mul_pd(xd, xd), _mm256_mul_pd(yd, yd));
+		__m256d closer = _mm256_andnot_pd(_mm256_cmp_pd(index, skip_index, _CMP_EQ_OQ),
+		                                  _mm256_cmp_pd(d, lane_best, _CMP_LT_OQ));
+		lane_best = _mm256_blendv_pd(lane_best, d, closer);
+		lane_index = _mm256_blendv_pd(lane_index, index, closer);
+		index = _mm256_add_pd(index, step);
+	}
+	double lane_bests[lanes], lane_indexes[lanes];
+	_mm256_storeu_pd(lane_bests, lane_best);
+	_mm256_storeu_pd(lane_indexes, lane_index);
+	combine_lanes(lane_bests, lane_indexes, lanes, best, best_index);
+#elif defined(GEOMETRY_SSE2)
+	const int lanes = 2;
+	__m128d px = _mm_set1_pd(p.x), py = _mm_set1_pd(p.y);
+	__m128d skip_index = _mm_set1_pd(skip);
+	__m128d index = _mm_set_pd(1., 0.), step = _mm_set1_pd(lanes);
+	__m128d lane_best = _mm_set1_pd(NO_DISTANCE), lane_index = _mm_set1_pd(-1.);
+	for (; i + lanes <= n; i += lanes) {
+		__m128d xd = _mm_sub_pd(_mm_loadu_pd(xs + i), px);
+		__m128d yd = _mm_sub_pd(_mm_loadu_pd(ys + i), py);
+		__m128d d = _mm_add_pd(_mm_mul_pd(xd, xd), _mm_mul_pd(yd, yd));
+		__m128d closer = _mm_andnot_pd(_mm_cmpeq_pd(index, skip_index), _mm_cmplt_pd(d, lane_best));
+		lane_best = _mm_or_pd(_mm_and_pd(closer, d), _mm_andnot_pd(closer, lane_best));
+		lane_index = _mm_or_pd(_mm_and_pd(closer, index), _mm_andnot_pd(closer, lane_index));
+		index = _mm_add_pd(index, step);
+	}
+	double lane_bests[lanes], lane_indexes[lanes];
+	_mm_storeu_pd(lane_bests, lane_best);
+	_mm_storeu_pd(lane_indexes, lane_index);
+	combine_lanes(lane_bests, lane_indexes, lanes, best, best_index);
+#endif
+	
+	for (; i < n; ++i) {
+		if (i == skip) {
+			continue;
+		}
+		double d = cartesian_distance_squared(p, Point(xs[i], ys[i]));
+		if (d < best) {
+			best = d;
+			best_index = i;
+		}
+	}
+	return best_index;
+}
+
+void in_range_mask(const double* xs, const double* ys, int n, Point p, double range,
+                   unsigned char* out)
+{
+	int i = 0;
+#if defined(GEOMETRY_AVX)
+	__m256d px = _mm256_set1_pd(p.x), py = _mm256_set1_pd(p.y), r = _mm256_set1_pd(range);
+	for (; i + 4 <= n; i += 4) {
+		__m256d xd = _mm256_sub_pd(_mm256_loadu_pd(xs + i), px);
+		__m256d yd = _mm256_sub_pd(_mm256_loadu_pd(ys + i), py);
+		__m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(xd, xd), _mm256_mul_pd(yd, yd)));
+		int bits = _mm256_movemask_pd(_mm256_cmp_pd(d, r, _CMP_LE_OQ));
+		for (int lane = 0; lane < 4; ++lane) {
+			out[i + lane] = (bits >> lane) & 1;
+		}
+	}
+#elif defined(GEOMETRY_SSE2)
+	__m128d px = _mm_set1_pd(p.x), py = _mm_set1_pd(p.y), r = _mm_set1_pd(range);
+	for (; i + 2 <= n; i += 2) {
+		__m128d xd = _mm_sub_pd(_mm_loadu_pd(xs + i), px);
+		__m128d yd = _mm_sub_pd(_mm_loadu_pd(ys + i), py);
+		__m128d d = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(xd, xd), _mm_mul_pd(yd, yd)));
+		int bits = _mm_movemask_pd(_mm_cmple_pd(d, r));
+		out[i] = bits & 1;
+		out[i + 1] = (bits >> 1) & 1;
+	}
+#endif
+	// The square root is exact to the last bit, so this agrees with cartesian_distance.
+	for (; i < n; ++i) {
+		out[i] = sqrt(cartesian_distance_squared(p, Point(xs[i], ys[i]))) <= range;
+	}
+}
@@ -0,0 +1,31 @@
+#ifndef GEOMETRY_KERNELS_H_
+#define GEOMETRY_KERNELS_H_
+
+/*
+ Batch versions of the Geometry calculations, working on many points at once.
+ The points are given as separate arrays of x and y coordinates so that several
+ of them can be loaded into one vector register. AVX is used when the compiler
+ targets it (e.g. make SIMD=-mavx2), SSE2 otherwise on x86, and plain loops on
+ anything else or with make SIMD=-DSCALAR_GEOMETRY. Every version gives
+ bit-identical results to the scalar Geometry functions, since they do the same
+ IEEE operations in the same order.
+ */
+
+struct Point;
+
+// return the square of the distance between two Points, for comparing
+// distances when only their order matters
+double cartesian_distance_squared(const Point& p1, const Point& p2);
+
+// store the squared distance from p to each of the n points in out
+void squared_distances(const double* xs, const double* ys, int n, Point p, double* out);
+
+// return the index of the point closest to p, ignoring the point at index skip
+// (pass -1 to consider them all); the earliest index wins a tie, -1 if there is none
+int min_distance_index(const double* xs, const double* ys, int n, Point p, int skip = -1);
+
+// set out[i] to 1 if point i is no farther than range from p, 0 if it is
+void in_range_mask(const double* xs, const double* ys, int n, Point p, double range,
+                   unsigned char* out);
+
+#endif
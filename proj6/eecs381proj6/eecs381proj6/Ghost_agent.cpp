@@ -0,0 +1,40 @@
+#include "Ghost_agent.h"
+
+#include "Model.h"
+
+#include <iostream>
+#include <memory>
+
+using std::string;
+using std::endl;
+using std::shared_ptr;
+
+Ghost_agent::Ghost_agent(const string& name_, Point location_) :
+  AgentIndividual{name_, location_},
+  location{location_},
+  damage{0} {}
+
+void Ghost_agent::set_location(Point location_)
+{
+  location = location_;
+  Model::get().notify_location(get_name(), location);
+}
+
+// save the hit for the owner
+void Ghost_agent::take_hit(int attack_strength, AgentIndividual& attacker)
+{
+  damage += attack_strength;
+}
+
+// return the damage saved up since the last call, and forget it
+int Ghost_agent::take_damage()
+{
+  int taken = damage;
+  damage = 0;
+  return taken;
+}
+
+void Ghost_agent::describe() const
+{
+  Model::get().out() << "Ghost of " << get_name() << " at " << location << endl;
+}
@@ -0,0 +1,50 @@
+#ifndef GHOST_AGENT_H_
+#define GHOST_AGENT_H_
+
+/*
+ 
+ A Ghost_agent stands in for an agent that another Model owns, one near enough
+ to the edge of this Model's region that local agents could reach it. It sits
+ where the owner last said the agent was, and never moves or acts by itself.
+ Hits it takes are saved up for the owner rather than applied.
+ 
+*/
+
+#include "AgentIndividual.h"
+#include "Geometry.h"
+
+#include <memory>
+#include <string>
+
+class Ghost_agent : public AgentIndividual {
+public:
+  
+  Ghost_agent(const std::string& name_, Point location_);
+  
+  // where the owner last said the agent was
+  Point get_location() const override
+    { return location; }
+  void set_location(Point location_);
+  
+  // save the hit for the owner; there is no one here to strike back or run away
+  void take_hit(int attack_strength, AgentIndividual& attacker) override;
+  
+  // return the damage saved up since the last call, and forget it
+  int take_damage();
+  
+  // the owner does the moving
+  void update() override {}
+  bool can_coarsen() const override
+    { return false; }
+  
+  void describe() const override;
+  
+  std::string get_type() const override
+    { return "Ghost"; }
+  
+private:
+  Point location;
+  int damage;
+};
+
+#endif
@@ -2,38 +2,82 @@
 #include "ListView.h"
 
 #include <iostream>
+#include <sstream>
 
 using std::cout; using std::endl;
+using std::ostringstream;
 using std::string;
 
+const string LIST_SEPARATOR = "--------------\n";
+
 // Base List View //
 ListView::~ListView() {} // explicit dtor
 
 // Notify for removal of object
 void ListView::update_remove(const string& name)
 {
-  objects.erase(name);
+  if (objects.erase(name)) {
+    buffer_stale = true;
+  }
 }
 
 // prints out the view
 void ListView::draw()
 {
-  cout << "Current " << view_name() << ":" << endl;
-  cout << "--------------" << endl;
-  for (auto i : objects) {
-    cout << i.first << ": " << i.second << endl;
+  // If the console format changed, every cached row is formatted wrong.
+  if (cout.flags() != line_flags || cout.precision() != line_precision) {
+    line_flags = cout.flags();
+    line_precision = cout.precision();
+    for (auto &i : objects) {
+      i.second.dirty = true;
+    }
+    buffer_stale = true;
   }
-  cout << "--------------" << endl;
+  
+  if (buffer_stale) {
+    rebuild_buffer();
+  }
+  cout.write(buffer.data(), buffer.size());
 }
 
 // discards the view's contents
 void ListView::clear()
 {
   objects.clear();
+  buffer_stale = true;
 }
 
 // update the generic value held by the ListView
 void ListView::update_value(const string& name, double value)
 {
-  objects[name] = value;
+  Entry &entry = objects[name];
+  if (entry.dirty || entry.value != value) {
+    entry.value = value;
+    entry.dirty = true;
+    buffer_stale = true;
+  }
+}
+
+// rebuild the output buffer, formatting only the dirty rows
+void ListView::rebuild_buffer()
+{
+  ostringstream row;
+  row.flags(line_flags);
+  row.precision(line_precision);
+  
+  buffer.clear();
+  buffer += "Current " + view_name() + ":\n";
+  buffer += LIST_SEPARATOR;
+  for (auto &i : objects) {
+    Entry &entry = i.second;
+    if (entry.dirty) {
+      row.str("");
+      row << i.first << ": " << entry.value << '\n';
+      entry.line = row.str();
+      entry.dirty = false;
+    }
+    buffer += entry.line;
+  }
+  buffer += LIST_SEPARATOR;
+  buffer_stale = false;
 }
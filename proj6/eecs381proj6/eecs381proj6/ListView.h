@@ -7,12 +7,15 @@
  
  This view is capable of rendering a list of doubles
  which correspond to some statistic about an observed 
- object.
+ object. Each row is formatted once when its value changes
+ and kept in a cache, so a draw only re-formats the rows that
+ changed and writes the whole list out in one piece.
  
 */
 
 #include "View.h"
 
+#include <ios>
 #include <string>
 #include <map>
 
@@ -30,7 +33,13 @@ public:
 	void clear() override;
   
 protected:
-  using Objects_t = std::map<std::string, double>;
+  // a value along with its formatted output row
+  struct Entry {
+    double value = 0.0;
+    std::string line;
+    bool dirty = true;
+  };
+  using Objects_t = std::map<std::string, Entry>;
   
   // update the generic value held by the ListView
   void update_value(const std::string& name, double value);
@@ -39,7 +48,18 @@ private:
   // get the name of this view type
   virtual std::string view_name() = 0;
   
+  // rebuild the output buffer, formatting only the dirty rows
+  void rebuild_buffer();
+  
   Objects_t objects;
+  
+  // the complete output of the last draw, and whether it needs rebuilding
+  std::string buffer;
+  bool buffer_stale = true;
+  
+  // the stream format the cached rows were formatted with
+  std::ios::fmtflags line_flags = std::ios::fmtflags();
+  std::streamsize line_precision = 0;
 };
 
 #endif
@@ -3,12 +3,14 @@
 
 #include <iostream>
 
-using std::cout; using std::endl;
+using std::ostream; using std::endl;
 using std::string;
 
 const double DEFAULT_LOCAL_SCALE = 2.0;
 const int DEFAULT_LOCAL_SIZE = 9;
 const double LOCAL_ORIGIN_OFFSET = (DEFAULT_LOCAL_SIZE / 2.0) * DEFAULT_LOCAL_SCALE;
+// see one extra cell past the edges so rounding never hides an object on the border
+const double LOCAL_VIEW_RANGE = LOCAL_ORIGIN_OFFSET + DEFAULT_LOCAL_SCALE;
 LocalMapView::LocalMapView(string name) : obj_name(name)
 {
   set_scale(DEFAULT_LOCAL_SCALE);
@@ -25,9 +27,16 @@ void LocalMapView::update_location(const string& name, Point location)
   }
 }
 
-void LocalMapView::print_header()
+void LocalMapView::print_header(ostream& os)
 {
-  cout << "Local view for: " << obj_name << endl;
+  os << "Local view for: " << obj_name << endl;
+}
+
+bool LocalMapView::get_followed_area(string& name, double& range) const
+{
+  name = obj_name;
+  range = LOCAL_VIEW_RANGE;
+  return true;
 }
 
 
@@ -22,10 +22,13 @@ public:
   void update_location(const std::string& name, Point location) override;
   
   // print the headder for the local view
-  void print_header() override;
+  void print_header(std::ostream& os) override;
+  
+  // we only need locations near the object we follow
+  bool get_followed_area(std::string& name, double& range) const override;
   
   // don't print anything for off map
-  void print_off_map(std::vector<std::string> &off) override {};
+  void print_off_map(std::ostream& os, std::vector<std::string> &off) override {};
   
 private:
   std::string obj_name;
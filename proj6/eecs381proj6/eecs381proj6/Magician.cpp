@@ -13,7 +13,7 @@
 
 using std::vector;
 using std::string;
-using std::cout; using std::endl;
+using std::endl;
 using std::shared_ptr;
 using std::for_each;
 using std::bind;
@@ -35,35 +35,32 @@ void Magician::update()
   Warrior::update();
   
   // If we aren't attacking, bless the peaceful people.
-  if (!is_attacking()) {
-    auto agents_in_range = Model::get().find_agents_in_range(shared_from_this(), blessing_range);
+  if (is_alive() && !is_attacking()) {
+    auto agents_in_range = Model::get().find_agents_in_range(*this, blessing_range);
     agents_in_range->accept_blessing(blessing_strength, shared_from_this());
   }
 }
 
 // Magicians are wily, but poorly armored. A hit only has a 50% chance of landing, but
 // if it does, it kills the Magician immediately, regardless of attack_strength.
-void Magician::take_hit(int attack_strength, shared_ptr<AgentIndividual> attacker_ptr)
+void Magician::take_hit(int attack_strength, AgentIndividual& attacker)
 {
   // "random" simulation
   // ideally we'd use a *real* random number here
-  static int rand = 0;
-  
-  // change to rand() % 2 and remove the static int
-  int hit_landed = rand++ % 2;
+  int hit_landed = Model::get().next_chance_number() % 2;
   
   if (hit_landed == 1) {
     // The hit landed.
-    AgentIndividual::take_hit(numeric_limits<int>::max(), attacker_ptr);
+    AgentIndividual::take_hit(numeric_limits<int>::max(), attacker);
   } else {
     // The hit missed.
-    cout << get_name() << ": Aha! You missed!" << endl;
+    Model::get().out() << get_name() << ": Aha! You missed!" << endl;
   }
 }
 
 void Magician::describe() const
 {
-  cout << "Magician ";
+  Model::get().out() << "Magician ";
   Warrior::describe();
 }
 
@@ -26,7 +26,7 @@ public:
   
   // Overrides AgentComponent's take_hit to see if hit actually lands. If so, the Magician is killed
   // regardless of attack_strength.
-  void take_hit(int attack_strength, std::shared_ptr<AgentIndividual> attacker_ptr) override;
+  void take_hit(int attack_strength, AgentIndividual& attacker) override;
   
   // output information specific to magician
   void describe() const override;
@@ -34,6 +34,9 @@ public:
   // return the battle cry for a Magician
   std::string get_battle_cry() override;
   
+  std::string get_type() const override
+    { return "Magician"; }
+  
 private:
   int blessing_strength;
   double blessing_range;
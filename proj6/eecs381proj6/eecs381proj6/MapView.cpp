@@ -5,12 +5,13 @@
 #include "Utility.h"
 
 #include <cmath>
-#include <iomanip>
+#include <cstdio>
 #include <iostream>
 #include <memory>
 
 using std::cout; using std::endl;
-using std::setw; using std::setprecision;
+using std::ostream;
+using std::snprintf;
 using std::string; using std::vector;
 using std::shared_ptr;
 using std::make_shared;
@@ -21,8 +22,17 @@ const double MIN_SIZE = 6.0;
 const double DEFAULT_SCALE = 2.0;
 const Point DEFAULT_ORIGIN {-10.0,-10.0};
 
-const string BLANK_CORDINATE = ". ";
-const string MULTI_CORDINATE = "* ";
+const char BLANK_CORDINATE[] = ". ";
+const char MULTI_CORDINATE[] = "* ";
+const int CELL_WIDTH = 2;
+const int LABEL_WIDTH = 4;
+const int LABEL_INTERVAL = 3;
+
+// ANSI escape sequences for ANSI mode
+const string ANSI_SAVE_CURSOR = "\0337";
+const string ANSI_RESTORE_CURSOR = "\0338";
+const string ANSI_CLEAR_LINE = "\033[K";
+const string ANSI_CLEAR_BELOW = "\033[J";
 
 // explicit default dtor
 MapView::~MapView() {}
@@ -47,6 +57,13 @@ void MapView::clear()
   objects.clear();
 }
 
+// draw only the changes since the last frame using ANSI cursor movement
+void MapView::set_ansi_mode(bool ansi_mode_)
+{
+  ansi_mode = ansi_mode_;
+  last_lines.clear();
+}
+
 // modify the display parameters
 // if the size is out of bounds will throw
 void MapView::set_size(int size_)
@@ -84,96 +101,146 @@ void MapView::set_defaults()
 
 void MapView::draw()
 {
-  Grid_t grid;
-  print_header();
-  init_grid_data(grid);
-  print_grid(grid);
+  // The header and off map lines are formatted just like the rest of the console output.
+  text.str("");
+  text.flags(cout.flags());
+  text.precision(cout.precision());
+  
+  print_header(text);
+  init_grid_data(text);
+  
+  frame = text.str();
+  print_grid();
+  write_frame();
 }
 
-void MapView::print_header()
+void MapView::print_header(ostream& os)
 {
-  cout << "Display size: " << size << ", scale: ";
-  cout << scale << ", origin: " << origin << endl;
+  os << "Display size: " << size << ", scale: ";
+  os << scale << ", origin: " << origin << endl;
 }
 
-void MapView::print_off_map(vector<string> &off)
+void MapView::print_off_map(ostream& os, vector<string> &off)
 {
   for (auto itr = off.begin(); itr != off.end(); itr++) {
     if (itr != off.begin()) {
-      cout << ", ";
+      os << ", ";
     }
-    cout << *itr;
+    os << *itr;
   }
   if (off.size()) {
-    cout << " outside the map" << endl;
+    os << " outside the map" << endl;
   }
 }
 
-MapView::Grid_t MapView::make_grid(int size)
+void MapView::init_grid_data(ostream& os)
 {
-  Grid_t grid(size);
-  for (auto &row : grid) {
-    row.resize(size);
-    for (auto &col : row) {
-      col = BLANK_CORDINATE;
-    }
+  // setup grid, reusing the storage from the last draw
+  grid.resize(size * size * CELL_WIDTH);
+  for (int i = 0; i < size * size; ++i) {
+    grid[i * CELL_WIDTH] = BLANK_CORDINATE[0];
+    grid[i * CELL_WIDTH + 1] = BLANK_CORDINATE[1];
   }
-  return grid;
-}
-
-void MapView::init_grid_data(Grid_t &grid)
-{
-  // setup grid
-  grid = make_grid(size);
   
   // init cells of grid
   vector<string> off_map;
   for (auto &i : objects) {
     int ix, iy;
     if(get_subscripts(ix, iy, i.second)) {
-      if(grid[iy][ix] == BLANK_CORDINATE) {
-        grid[iy][ix] = i.first.substr(0,2);
+      char *cell = &grid[(iy * size + ix) * CELL_WIDTH];
+      if(cell[0] == BLANK_CORDINATE[0] && cell[1] == BLANK_CORDINATE[1]) {
+        cell[0] = i.first[0];
+        cell[1] = i.first.size() > 1 ? i.first[1] : ' ';
       } else {
         // unit is already here, show *
-        grid[iy][ix] = MULTI_CORDINATE;
+        cell[0] = MULTI_CORDINATE[0];
+        cell[1] = MULTI_CORDINATE[1];
       }
     } else { // not on map
       off_map.push_back(i.first);
     }
   }
   
-  print_off_map(off_map);
+  print_off_map(os, off_map);
 }
 
-// print the provided grid, regardless of view type
-void MapView::print_grid(const Grid_t &grid)
+// append the grid and its axis labels to the frame, regardless of view type
+void MapView::print_grid()
 {
-  // dont print decimal points
-  auto old_prec = cout.precision();
-  cout.precision(0);
+  // a label is at most a sign, the digits of a double, and the terminator
+  char label[LABEL_WIDTH + 320];
+  
+  frame.reserve(frame.size() + (size + 1) * (LABEL_WIDTH + 2 + size * CELL_WIDTH));
   for (int i = size-1; i >= 0; --i) {
-    // y axis labels
-    if(i % 3 == 0) {
-      double label = round(i * scale + origin.y);
-      cout << setw(4) << label << " ";
-    } else cout << "     ";
-    for (auto &str : grid[i]) {
-      cout << setw(2) << str;
-    }
-    cout << endl;
+    // y axis labels, without decimal points
+    if(i % LABEL_INTERVAL == 0) {
+      snprintf(label, sizeof(label), "%*.0f ", LABEL_WIDTH, round(i * scale + origin.y));
+      frame += label;
+    } else frame.append(LABEL_WIDTH + 1, ' ');
+    frame.append(&grid[i * size * CELL_WIDTH], size * CELL_WIDTH);
+    frame += '\n';
   }
   
   // label x axis
   for (int i = 0; i < size; ++i) {
-    if (i % 3 == 0) {
-      double label = round(i * scale + origin.x);
-      cout << "  " << setw(4) << label;
+    if (i % LABEL_INTERVAL == 0) {
+      snprintf(label, sizeof(label), "  %*.0f", LABEL_WIDTH, round(i * scale + origin.x));
+      frame += label;
     }
   }
-  cout << endl;
+  frame += '\n';
+}
+
+// write the frame, or just its changes in ANSI mode
+void MapView::write_frame()
+{
+  if (!ansi_mode) {
+    cout.write(frame.data(), frame.size());
+    return;
+  }
+  
+  // split the frame into lines
+  vector<string> lines;
+  for (string::size_type start = 0, end; start < frame.size(); start = end + 1) {
+    end = frame.find('\n', start);
+    lines.push_back(frame.substr(start, end - start));
+  }
+  
+  // Build the escape sequences for the lines that changed, placing the frame
+  // at the top of the terminal and putting the cursor back afterwards.
+  string changes = ANSI_SAVE_CURSOR;
+  char move[32];
+  bool redraw = lines.size() != last_lines.size();
+  for (vector<string>::size_type row = 0; row < lines.size(); ++row) {
+    const string &line = lines[row];
+    if (redraw || line.size() != last_lines[row].size()) {
+      snprintf(move, sizeof(move), "\033[%d;1H", int(row) + 1);
+      changes += move + line + ANSI_CLEAR_LINE;
+      continue;
+    }
+    // write each run of changed characters
+    string::size_type col = 0;
+    while (col < line.size()) {
+      if (line[col] == last_lines[row][col]) {
+        ++col;
+        continue;
+      }
+      string::size_type run = col;
+      while (run < line.size() && line[run] != last_lines[row][run]) ++run;
+      snprintf(move, sizeof(move), "\033[%d;%dH", int(row) + 1, int(col) + 1);
+      changes += move;
+      changes.append(line, col, run - col);
+      col = run;
+    }
+  }
+  if (redraw) {
+    changes += ANSI_CLEAR_BELOW;
+  }
+  changes += ANSI_RESTORE_CURSOR;
   
-  // restore precision
-  cout.precision(old_prec);
+  cout.write(changes.data(), changes.size());
+  cout.flush();
+  last_lines.swap(lines);
 }
 
 // Calculate the cell subscripts corresponding to the supplied location parameter,
@@ -10,11 +10,21 @@
  virtual methods, called in draw, which can be overriden to customize
  the way the grid is printed.
  
+ The whole frame is formatted into a buffer that is kept between draws
+ and written out at once. In ANSI mode the frame is kept at the top of
+ the terminal, and each draw only rewrites the characters that changed
+ since the previous frame. The frame is placed by absolute row, so ANSI
+ mode needs a terminal (or a screen or tmux window) given over to the map:
+ output that scrolls the frame up leaves the old rows behind, and a frame
+ that changes height clears everything below it.
+ 
 */
 
 #include "View.h"
 #include "Geometry.h"
 
+#include <iosfwd>
+#include <sstream>
 #include <string>
 #include <map>
 #include <vector>
@@ -34,16 +44,20 @@ public:
 	// Discard the saved information - drawing will show only a empty pattern
 	void clear() override;
   
+  // draw only the changes since the last frame using ANSI cursor movement,
+  // on the top rows of the terminal
+  void set_ansi_mode(bool ansi_mode_);
+  
 protected:
   using Objects_t = std::map<std::string, Point>;
-  using Grid_t = std::vector<std::vector<std::string>>;
+  using Grid_t = std::vector<char>;
   
   // prints out the current map
 	void draw() override;
   // default header print, called during draw
-  virtual void print_header();
+  virtual void print_header(std::ostream& os);
   // override to handle object out of range of the bounds
-  virtual void print_off_map(std::vector<std::string> &off);
+  virtual void print_off_map(std::ostream& os, std::vector<std::string> &off);
   
   // modify the display parameters
 	void set_size(int size_);
@@ -52,15 +66,24 @@ protected:
 	void set_defaults();
   
 private:
-  Grid_t make_grid(int size);
-  void init_grid_data(Grid_t &grid);
-  void print_grid(const Grid_t &grid);
+  void init_grid_data(std::ostream& os);
+  void print_grid();
   bool get_subscripts(int &ix, int &iy, Point location) const;
+  // write the frame, or just its changes in ANSI mode
+  void write_frame();
   
   Objects_t objects;
   int size;
   double scale;
   Point origin;
+  
+  // buffers reused from one draw to the next
+  Grid_t grid;              // two characters per cell, row by row
+  std::ostringstream text;  // header and off map lines
+  std::string frame;
+  
+  bool ansi_mode = false;
+  std::vector<std::string> last_lines; // the frame on screen, in ANSI mode
 };
 
 #endif
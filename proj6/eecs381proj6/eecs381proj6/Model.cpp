@@ -6,7 +6,9 @@
 #include "AgentGroup.h"
 #include "Agent_factory.h"
 #include "Geometry.h"
+#include "Geometry_kernels.h"
 #include "Sim_object.h"
+#include "Spatial_index.h"
 #include "Structure.h"
 #include "Structure_factory.h"
 #include "Utility.h"
@@ -17,37 +19,35 @@
 #include <iostream>
 #include <memory>
 
-using std::cout; using std::endl;
+using std::cout; using std::ostream;
 using std::string; using std::map; using std::vector;
 using std::make_pair; using std::make_shared;
-using std::shared_ptr; using std::unique_ptr;
-using std::bind;
-using std::min_element;
-using namespace std::placeholders;
+using std::shared_ptr; using std::unique_ptr; using std::dynamic_pointer_cast;
+using std::function; using std::set;
+using std::move;
+using std::lower_bound;
+using std::sort;
 
 const int UNIQUE_STRING_PREFIX_SIZE = 2;
+// the farthest an agent acts on another without being told to, a Magician's blessing
+const double LOD_INTERACTION_RANGE = 10.0;
+// every agent moves at the default speed
+const double LOD_AGENT_SPEED = 5.0;
 
-// Returns a boolean indicating whether or not s1 is closer to origin than s2. We deal
-// with self comparison (i.e. one of s1 or s2 is actually the origin object), by pushing
-// origin to the end of the list.
-bool sim_object_min_distance_comparator(const shared_ptr<Sim_object> origin,
-                                        const shared_ptr<Sim_object> s1,
-                                        const shared_ptr<Sim_object> s2)
-{
-  // If s1 and origin are the same object, s2 should always come first.
-  if (s1 == origin) {
-    return false;
-  }
-  // Similarly, if s2 and origin are the same object, s1 should always come first.
-  if (s2 == origin) {
-    return true;
-  }
-  
-  return cartesian_distance(s1->get_location(), origin->get_location()) <
-         cartesian_distance(s2->get_location(), origin->get_location());
-}
+// the square around a followed object that a view wants locations from
+struct Model::View_area {
+  string followed;
+  double range;
+  Point center;
+};
+
+// the Model made current for this thread, if any
+thread_local Model* current_model = nullptr;
 
-Model::Model() : time{0}
+Model::Model() : Model(cout) {}
+
+Model::Model(ostream& output_) :
+  time{0}, output{&output_}, chance_number{0}, lod_interval{1}, spatial_index{new Spatial_index}
 {
   insert_structure(create_structure("Rivendale", "Farm", Point(10., 10.)));
   insert_structure(create_structure("Sunnybrook", "Farm", Point(0., 30.)));
@@ -62,45 +62,52 @@ Model::Model() : time{0}
 
 }
 
-// return singleton instance of model
+// Explicit default destructor, the View_area and Spatial_index types are complete here.
+Model::~Model() {}
+
+// return the current Model of the calling thread, or the main Model if none is current
 Model& Model::get()
 {
+  if (current_model) {
+    return *current_model;
+  }
   static Model m;
   return m;
 }
 
+Model::Scope::Scope(Model& model) : previous{current_model}
+{
+  current_model = &model;
+}
+
+Model::Scope::~Scope()
+{
+  current_model = previous;
+}
+
 // is name already in use for either an AgentComponent or a Structure?
 // either the identical name, or identical in first two characters counts as in-use
 
+// Every agent, including those in groups, is also an object, so the counts of
+// object name prefixes cover them all.
 bool Model::is_name_in_use(const string& name) const
 {
-  string prefix = name.substr(0, UNIQUE_STRING_PREFIX_SIZE);
-  
-  // Check if the name is used by an object.
-  auto itr = objects.lower_bound(prefix);
-  if (itr != objects.end() && itr->first.find(prefix) == 0) {
-    return true;
-  }
-  
-  // Check to see if the name is used by a group.
-  for (auto& component : agent_components) {
-    if (component.second->has_prefix(prefix)) {
-      return true;
-    }
+  if (name.empty()) {
+    return !objects.empty();
   }
-  return false;
+  return name_prefixes.count(name.substr(0, UNIQUE_STRING_PREFIX_SIZE)) > 0;
 }
 
 // check if the full name given matches an existing object
 bool Model::object_fullname_exists(const std::string &name) const {
-  auto itr = objects.find(name);
+  auto itr = objects.find(&name);
   return itr != objects.end();
 }
 
 // is there a structure with this name?
 bool Model::is_structure_present(const string& name) const
 {
-  return structures.find(name) != structures.end();
+  return structures.find(&name) != structures.end();
 }
 
 // add a new structure; assumes none with the same name
@@ -116,37 +123,35 @@ shared_ptr<Structure> Model::get_structure_ptr(const string& name) const
   if (!is_structure_present(name)) {
     throw Error("Structure not found!");
   }
-  return structures.find(name)->second;
+  return structures.find(&name)->second;
 }
 
 // returns the closest structure to the provided agent
-shared_ptr<Structure> Model::closest_structure(shared_ptr<Sim_object> object) const
+shared_ptr<Structure> Model::closest_structure(const Sim_object& object) const
 {
   // Check if the object arg is the only structure.
-  if (structures.size() == 1 && structures.at(object->get_name()) == object) {
+  if (structures.size() == 1 && structures.begin()->second.get() == &object) {
     return shared_ptr<Structure>();
   }
   
-  auto closest_structure_it =
-  min_element(structures.begin(),
-              structures.end(),
-              bind(sim_object_min_distance_comparator,
-                   object,
-                   bind(&Structures_t::value_type::second, _1),
-                   bind(&Structures_t::value_type::second, _2)));
+  // Skip the object itself if it is one of the structures.
+  int skip = -1;
+  auto name_itr = lower_bound(structure_names.begin(), structure_names.end(), &object.get_name(),
+                              Name_ptr_less());
+  if (name_itr != structure_names.end() && **name_itr == object.get_name() &&
+      structures.at(*name_itr).get() == &object) {
+    skip = int(name_itr - structure_names.begin());
+  }
   
-  return closest_structure_it->second;
+  int closest = min_distance_index(structure_xs.data(), structure_ys.data(), int(structure_xs.size()),
+                                   object.get_location(), skip);
+  return structures.at(structure_names[closest]);
 }
 
 // is there an agent with this name?
 bool Model::is_agent_component_present(const string& name) const
 {
-  for (auto& component : agent_components) {
-    if (component.second->get_component(name)) {
-      return true;
-    }
-  }
-  return false;
+  return component_index.count(&name) > 0;
 }
 
 // is this agent component in a group?
@@ -174,25 +179,98 @@ bool Model::are_in_same_group(const string &a1, const string &a2) const
   return false;
 }
 
+// the name of the outermost group holding the agent component, empty if it isn't in one
+string Model::get_group_name(const string& name) const
+{
+  for (auto& component : agent_components) {
+    if (*component.first != name && component.second->get_component(name)) {
+      return *component.first;
+    }
+  }
+  return string();
+}
+
 // add agent individual, throws if name is already in use
 void Model::add_new_agent(shared_ptr<AgentIndividual> new_agent)
 {
   insert_new_agent(new_agent);
+  end_coarse_near(new_agent->get_location(), LOD_INTERACTION_RANGE);
   new_agent->broadcast_current_state();
 }
 
+// add many new objects at once, broadcasting only when they are all in
+void Model::add_objects_in_bulk(const vector<shared_ptr<Structure>>& new_structures,
+                                const vector<shared_ptr<AgentIndividual>>& new_agents,
+                                const vector<shared_ptr<AgentComponent>>& new_components)
+{
+  // Gather the new objects in name order, so each insertion can start from the last one.
+  vector<shared_ptr<Sim_object>> new_objects(new_structures.begin(), new_structures.end());
+  new_objects.insert(new_objects.end(), new_agents.begin(), new_agents.end());
+  auto name_order = [](const shared_ptr<Sim_object>& a, const shared_ptr<Sim_object>& b)
+      { return a->get_name() < b->get_name(); };
+  sort(new_objects.begin(), new_objects.end(), name_order);
+  
+  // Check every name before changing anything.
+  for (auto itr = new_objects.begin(); itr != new_objects.end(); ++itr) {
+    if (objects.count(&(*itr)->get_name()) || component_index.count(&(*itr)->get_name()) ||
+        (itr != new_objects.begin() && (*(itr - 1))->get_name() == (*itr)->get_name())) {
+      throw Error("Name is already in use!");
+    }
+  }
+  for (auto &component : new_components) {
+    if (objects.count(&component->get_name()) || component_index.count(&component->get_name())) {
+      throw Error("Name is already in use!");
+    }
+  }
+  
+  name_prefixes.reserve(name_prefixes.size() + new_objects.size());
+  auto hint = objects.end();
+  for (auto &object : new_objects) {
+    hint = objects.insert(hint, make_pair(&object->get_name(), object));
+    ++hint;
+    add_name_prefixes(object->get_name());
+    spatial_index->insert(object->get_name(), object->get_location());
+  }
+  
+  auto structure_hint = structures.end();
+  for (auto &s : new_structures) {
+    structure_hint = structures.insert(structure_hint, make_pair(&s->get_name(), s));
+  }
+  index_structures();
+  
+  component_index.reserve(component_index.size() + new_agents.size() + new_components.size());
+  agent_slots.reserve(agent_slots.size() + new_agents.size() + new_components.size());
+  for (auto &agent : new_agents) {
+    index_component(agent);
+    end_coarse_near(agent->get_location(), LOD_INTERACTION_RANGE);
+  }
+  for (auto &component : new_components) {
+    agent_components[&component->get_name()] = component;
+    if (!component_index.count(&component->get_name())) {
+      index_component(component);
+    }
+  }
+  
+  // Now that everything is in place, tell the views.
+  if (!views.empty()) {
+    for (auto &object : new_objects)
+      object->broadcast_current_state();
+  }
+}
+
 void Model::add_existing_agent_component(shared_ptr<AgentComponent> component)
 {
-  agent_components[component->get_name()] = component;
+  agent_components[&component->get_name()] = component;
 }
 
 // add a new agent component, does nothing with sim_objects
 void Model::add_new_agent_component(shared_ptr<AgentComponent> component)
 {
-  if (is_name_in_use(component->get_name())) {
+  if (is_name_in_use(component->get_name()) || component_index.count(&component->get_name())) {
     throw Error("Name is already in use!");
   }
-  agent_components[component->get_name()] = component;
+  agent_components[&component->get_name()] = component;
+  index_component(component);
 }
 
 // adds existing component to existing group
@@ -206,21 +284,17 @@ void Model::add_agent_component_to_group(shared_ptr<AgentComponent> component,
   
   // Will throw if add is not valid.
   group->add_component(component);
-  agent_components.erase(component->get_name());
+  agent_components.erase(&component->get_name());
 }
 
-// remove an individual agent, should only be called internally upon death.
-// assumes that named agent exists
+// queue an individual agent for removal, should only be called internally upon death.
+// The agent stays in our containers until the end of the tick, so nothing we are
+// iterating over is erased out from under us. assumes that named agent exists
 void Model::remove_agent(const string& name)
 {
-  // If we didn't erase it from our map, remove it from all components.
-  if (!agent_components.erase(name)) {
-    for (auto& component : agent_components) {
-      component.second->remove_component_if_present(name);
-    }
-  }
-  // Take him out of our sim objects as well.
-  objects.erase(name);
+  graveyard.insert(name);
+  // It is gone from the map right away, so no view can pick it up again.
+  spatial_index->remove(name);
 }
 
 // remove an agent component, don't touch sim objects
@@ -237,7 +311,35 @@ void Model::remove_agent_component(const string& name)
   component->disband();
   
   // Actually erase the group, we know it has been disbanded.
-  agent_components.erase(name);
+  agent_components.erase(&name);
+  unindex_component(name);
+}
+
+// take the agent out of every container, telling the views it is gone but
+// without any of the commotion of a death
+shared_ptr<AgentIndividual> Model::take_out_agent(const string& name_)
+{
+  // The name may belong to the agent, so hold a copy while erasing.
+  string name = name_;
+  auto object = objects.find(&name);
+  shared_ptr<AgentIndividual> agent;
+  if (object == objects.end() || !(agent = dynamic_pointer_cast<AgentIndividual>(object->second))) {
+    throw Error("Agent not found!");
+  }
+  
+  if (!agent_components.erase(&name)) {
+    set<string> names{name};
+    for (auto &component : agent_components)
+      component.second->remove_components_if_present(names);
+  }
+  unindex_component(name);
+  coarse_agents.erase(agent.get());
+  graveyard.erase(name);
+  spatial_index->remove(name);
+  objects.erase(object);
+  remove_name_prefixes(name);
+  notify_gone(name);
+  return agent;
 }
 
 // removes an existing agent component, does nothing with sim_objects
@@ -247,58 +349,121 @@ void Model::remove_agent_component_from_group(shared_ptr<AgentComponent> compone
   group->remove_component(component->get_name());
   
   // Add the component back to our collection of components.
-  agent_components[component->get_name()] = component;
+  agent_components[&component->get_name()] = component;
 }
 
 // will throw Error("Agent/Component not found!") if no agent component of that name
 shared_ptr<AgentComponent> Model::get_agent_comp_ptr(const string& name) const
 {
-  for (auto& component : agent_components) {
-    auto found_component = component.second->get_component(name);
-    if (found_component) {
-      return found_component;
-    }
+  auto itr = component_index.find(&name);
+  if (itr == component_index.end()) {
+    throw Error("Agent or Group not found!");
   }
-  throw Error("Agent or Group not found!");
+  return agent_slots[itr->second].component;
+}
+
+// a handle to the named agent component, one that never resolves if there is none
+Agent_handle Model::get_agent_handle(const string& name) const
+{
+  auto itr = component_index.find(&name);
+  if (itr == component_index.end()) {
+    return Agent_handle();
+  }
+  return Agent_handle(itr->second, agent_slots[itr->second].generation);
 }
 
 // returns the closest agent to the provided object (excluding 'object' itself)
-shared_ptr<AgentComponent> Model::closest_agent_in_range_not_in_group(shared_ptr<Sim_object> object,
+shared_ptr<AgentComponent> Model::closest_agent_in_range_not_in_group(const Sim_object& object,
                                                                       double range) const
 {
-  shared_ptr<AgentIndividual> closest_individual;
+  fill_range_batch(object.get_location(), range);
+  AgentIndividual* closest_individual = nullptr;
+  double closest_distance = 0.;
+  int index = 0;
   for (auto& component : agent_components) {
-    auto individual = component.second->get_nearest_in_range(object, range);
+    // A top level individual has its distance worked out already; a group finds its own.
+    AgentIndividual* individual = range_batch.individuals[index];
+    double distance = range_batch.squared_distances[index];
+    if (!individual) {
+      individual = component.second->get_nearest_in_range(object, range);
+      if (individual) {
+        distance = cartesian_distance_squared(object.get_location(), individual->get_location());
+      }
+    } else if (!range_batch.in_range[index] || !individual->is_alive()) {
+      individual = nullptr;
+    }
+    ++index;
     
     // ignore if out of range or not in the same group
-    if (!individual || are_in_same_group(object->get_name(), individual->get_name())) {
+    if (!individual || are_in_same_group(object.get_name(), individual->get_name())) {
       continue;
     }
     
-    if (!closest_individual ||
-        cartesian_distance(object->get_location(), individual->get_location()) <
-        cartesian_distance(object->get_location(), closest_individual->get_location())) {
+    if (!closest_individual || distance < closest_distance) {
       closest_individual = individual;
+      closest_distance = distance;
     }
   }
   
-  return closest_individual;
+  if (!closest_individual) {
+    return nullptr;
+  }
+  return closest_individual->shared_from_this();
 }
 
 // returns all agents within a certain range (excluding 'center' sim_object)
-shared_ptr<AgentComponent> Model::find_agents_in_range(shared_ptr<Sim_object> center,
+shared_ptr<AgentComponent> Model::find_agents_in_range(const Sim_object& center,
                                                        double range) const
 {
+  fill_range_batch(center.get_location(), range);
   auto agents_in_range = make_shared<AgentGroup>("");
+  int index = 0;
   for (auto& component : agent_components) {
-    auto comp = component.second->get_all_in_range(center, range);
-    if (comp) {
-      agents_in_range->add_component(comp);
+    AgentIndividual* individual = range_batch.individuals[index];
+    if (!individual) {
+      auto comp = component.second->get_all_in_range(center, range);
+      if (comp) {
+        agents_in_range->add_component(comp);
+      }
+    } else if (range_batch.in_range[index] && individual->is_alive()) {
+      agents_in_range->add_component(component.second);
     }
+    ++index;
   }
   return agents_in_range;
 }
 
+// Gathering the coordinates costs a pass over the agents, but the distances and range
+// checks then run several to a vector register, and give the same results as the
+// one at a time versions.
+void Model::fill_range_batch(Point location, double range) const
+{
+  Range_batch& batch = range_batch;
+  batch.individuals.clear();
+  batch.xs.clear();
+  batch.ys.clear();
+  for (auto& component : agent_components) {
+    auto individual = dynamic_cast<AgentIndividual*>(component.second.get());
+    Point point = individual ? individual->get_location() : location;
+    batch.individuals.push_back(individual);
+    batch.xs.push_back(point.x);
+    batch.ys.push_back(point.y);
+  }
+  
+  int n = int(batch.individuals.size());
+  batch.squared_distances.resize(n);
+  batch.in_range.resize(n);
+  squared_distances(batch.xs.data(), batch.ys.data(), n, location, batch.squared_distances.data());
+  in_range_mask(batch.xs.data(), batch.ys.data(), n, location, range, batch.in_range.data());
+}
+
+// call the function on every object in name order
+void Model::for_each_object(function<void (const shared_ptr<Sim_object>&)> func) const
+{
+  for (auto &i : objects)
+    func(i.second);
+}
+
 // tell all objects to describe themselves to the console
 void Model::describe() const
 {
@@ -310,8 +475,54 @@ void Model::describe() const
 void Model::update()
 {
   ++time;
-  for (auto &i : objects)
-    i.second->update();
+  if (lod_interval > 1 && time % lod_interval == 0) {
+    classify_lod();
+  }
+  
+  for (auto &i : objects) {
+    auto coarse = coarse_agents.find(i.second.get());
+    if (coarse == coarse_agents.end()) {
+      i.second->update();
+      continue;
+    }
+    
+    // A coarse agent catches up once a whole interval has gone by, or as soon as
+    // something, like being attacked, means it has to go back to the full schedule.
+    bool stays_coarse = i.second->can_coarsen();
+    if (stays_coarse && time - coarse->second < lod_interval) {
+      continue;
+    }
+    i.second->update_coarse(time - coarse->second);
+    if (stays_coarse) {
+      coarse->second = time;
+    } else {
+      coarse_agents.erase(coarse);
+    }
+  }
+  flush_graveyard();
+}
+
+void Model::set_lod_interval(int interval)
+{
+  if (interval < 1) {
+    throw Error("Interval must be positive!");
+  }
+  synchronize();
+  lod_interval = interval;
+  if (lod_interval == 1) {
+    coarse_agents.clear();
+  }
+}
+
+// bring every agent on the coarse schedule up to the current time
+void Model::synchronize()
+{
+  for (auto &i : coarse_agents) {
+    if (i.second < time) {
+      i.first->update_coarse(time - i.second);
+      i.second = time;
+    }
+  }
 }
 
 /* View services */
@@ -320,7 +531,22 @@ void Model::update()
 // with all current objects'location (or other state information).
 void Model::attach(shared_ptr<View> v)
 {
-  views.insert(v);
+  unique_ptr<View_area> area;
+  string followed;
+  double range;
+  if (v->get_followed_area(followed, range)) {
+    area.reset(new View_area{followed, range, Point()});
+    spatial_index->find(followed, area->center);
+  }
+  // Whatever the view can now see has to be on the full schedule.
+  if (area) {
+    end_coarse_near(area->center, area->range);
+  } else {
+    synchronize();
+    coarse_agents.clear();
+  }
+  views[v] = move(area);
+  
   for (auto &i : objects)
     i.second->broadcast_current_state();
 }
@@ -335,43 +561,59 @@ void Model::detach(shared_ptr<View> v)
 // notify the views about an object's location
 void Model::notify_location(const string& name, Point location)
 {
-  for (auto &i : views)
-    i->update_location(name, location);
+  Point old_location;
+  bool was_known = spatial_index->find(name, old_location);
+  spatial_index->insert(name, location);
+  
+  for (auto &i : views) {
+    View_area *area = i.second.get();
+    if (!area) {
+      i.first->update_location(name, location);
+    } else if (name == area->followed) {
+      i.first->update_location(name, location);
+      move_view_area(*i.first, *area, location);
+    } else if (in_square(location, area->center, area->range)) {
+      i.first->update_location(name, location);
+    } else if (was_known && in_square(old_location, area->center, area->range)) {
+      // It just left the area, so the view can forget it.
+      i.first->update_remove(name);
+    }
+  }
 }
 
 // notify the views about an object's health
 void Model::notify_health(const string& name, int health)
 {
   for (auto &i : views)
-    i->update_health(name, health);
+    i.first->update_health(name, health);
 }
 
 // notify the views about an object's amount
 void Model::notify_amount(const string& name, double amount)
 {
   for (auto &i : views)
-    i->update_amount(name, amount);
+    i.first->update_amount(name, amount);
 }
 
 // notify the views that an object is now gone
 void Model::notify_gone(const string& name)
 {
   for (auto &i : views)
-    i->update_remove(name);
+    i.first->update_remove(name);
 }
 
 // notify the views about an attack
 void Model::notify_attack(const std::string& name, const std::string& target)
 {
   for (auto &i : views)
-    i->update_attack(name, target);
+    i.first->update_attack(name, target);
 }
 
 // notify the views about the end of an attack
 void Model::notify_end_attack(const std::string &name)
 {
   for (auto &i : views)
-    i->update_end_attack(name);
+    i.first->update_end_attack(name);
 }
 
 // protected helpers //
@@ -379,14 +621,213 @@ void Model::notify_end_attack(const std::string &name)
 // dont broadcast state
 void Model::insert_structure(shared_ptr<Structure>s)
 {
-  auto spair = make_pair(s->get_name(), s);
-  objects.insert(spair);
+  auto spair = make_pair(&s->get_name(), s);
+  if (objects.insert(spair).second) {
+    add_name_prefixes(s->get_name());
+  }
   structures.insert(spair);
+  index_structures();
+  spatial_index->insert(s->get_name(), s->get_location());
+}
+
+// Structures never move, so their coordinates are laid out for closest_structure
+// only when one is added.
+void Model::index_structures()
+{
+  structure_names.clear();
+  structure_xs.clear();
+  structure_ys.clear();
+  for (auto &i : structures) {
+    structure_names.push_back(i.first);
+    structure_xs.push_back(i.second->get_location().x);
+    structure_ys.push_back(i.second->get_location().y);
+  }
 }
 
 void Model::insert_new_agent(shared_ptr<AgentIndividual> new_agent)
 {
   add_new_agent_component(new_agent);
-  objects[new_agent->get_name()] = new_agent;
+  objects[&new_agent->get_name()] = new_agent;
+  add_name_prefixes(new_agent->get_name());
+  spatial_index->insert(new_agent->get_name(), new_agent->get_location());
+}
+
+// give the component a slot in the agent table, reusing a free one if there is one
+void Model::index_component(shared_ptr<AgentComponent> component)
+{
+  int slot;
+  if (free_agent_slots.empty()) {
+    slot = int(agent_slots.size());
+    agent_slots.push_back(Agent_slot{component, 0});
+  } else {
+    slot = free_agent_slots.back();
+    free_agent_slots.pop_back();
+    agent_slots[slot].component = component;
+  }
+  component_index[&component->get_name()] = slot;
+}
+
+// free the named component's slot, moving it to a new generation so that any
+// handles to the component no longer resolve; no effect if the name isn't indexed
+void Model::unindex_component(const string& name)
+{
+  auto itr = component_index.find(&name);
+  if (itr == component_index.end()) {
+    return;
+  }
+  int slot = itr->second;
+  // The key points into the component, so erase it before letting the component go.
+  component_index.erase(itr);
+  agent_slots[slot].component.reset();
+  ++agent_slots[slot].generation;
+  free_agent_slots.push_back(slot);
+}
+
+// Agents are classified only every interval ticks, on the assumption that nothing
+// comes near an isolated agent faster than the agents move; an agent trained or
+// loaded nearby, an attack or a view breaks that, so those call this.
+void Model::end_coarse_near(Point location, double range)
+{
+  if (coarse_agents.empty()) {
+    return;
+  }
+  
+  // Gather them first, since catching up moves them in the spatial index.
+  double margin = 2 * lod_interval * LOD_AGENT_SPEED;
+  vector<Sim_object*> nearby;
+  spatial_index->for_each_in_square(location, range + margin, [&](const string& name, Point) {
+    auto object = objects.find(&name);
+    if (object != objects.end() && coarse_agents.count(object->second.get())) {
+      nearby.push_back(object->second.get());
+    }
+  });
+  for (Sim_object* object : nearby) {
+    auto coarse = coarse_agents.find(object);
+    if (coarse->second < time) {
+      object->update_coarse(time - coarse->second);
+    }
+    coarse_agents.erase(coarse);
+  }
+}
+
+// Called at the start of a tick. Every agent is first brought up to the end of the
+// last tick, so the decision is made on current locations; the margin then covers
+// how far this agent and any other could move before the next decision.
+void Model::classify_lod()
+{
+  for (auto &i : objects) {
+    Sim_object* object = i.second.get();
+    auto coarse = coarse_agents.find(object);
+    if (coarse != coarse_agents.end() && coarse->second < time - 1) {
+      object->update_coarse(time - 1 - coarse->second);
+      coarse->second = time - 1;
+    }
+  }
+  
+  for (auto &i : objects) {
+    Sim_object* object = i.second.get();
+    bool isolated = object->can_coarsen() && is_isolated(*object);
+    auto coarse = coarse_agents.find(object);
+    if (isolated && coarse == coarse_agents.end()) {
+      coarse_agents[object] = time - 1;
+    } else if (!isolated && coarse != coarse_agents.end()) {
+      coarse_agents.erase(coarse);
+    }
+  }
+}
+
+// is the object out of sight of every view and away from every other agent?
+bool Model::is_isolated(const Sim_object& object) const
+{
+  double margin = 2 * lod_interval * LOD_AGENT_SPEED;
+  Point location = object.get_location();
+  
+  for (auto &i : views) {
+    View_area *area = i.second.get();
+    // A view without an area sees everything.
+    if (!area || area->followed == object.get_name() ||
+        in_square(location, area->center, area->range + margin)) {
+      return false;
+    }
+  }
+  
+  bool isolated = true;
+  spatial_index->for_each_in_square(location, LOD_INTERACTION_RANGE + margin,
+                                    [&](const string& name, Point) {
+    if (name != object.get_name() && component_index.count(&name)) {
+      isolated = false;
+    }
+  });
+  return isolated;
+}
+
+// the followed object moved, send the view whatever entered or left its area
+void Model::move_view_area(View& view, View_area& area, Point new_center)
+{
+  Point old_center = area.center;
+  area.center = new_center;
+  
+  spatial_index->for_each_in_square(old_center, area.range, [&](const string& name, Point location) {
+    if (name != area.followed && !in_square(location, new_center, area.range)) {
+      view.update_remove(name);
+    }
+  });
+  spatial_index->for_each_in_square(new_center, area.range, [&](const string& name, Point location) {
+    if (name != area.followed && !in_square(location, old_center, area.range)) {
+      view.update_location(name, location);
+    }
+  });
+}
+
+// count the one and two character prefixes of the name
+void Model::add_name_prefixes(const string& name)
+{
+  for (string::size_type length = 1; length <= UNIQUE_STRING_PREFIX_SIZE && length <= name.size(); ++length) {
+    ++name_prefixes[name.substr(0, length)];
+  }
+}
+
+// uncount the one and two character prefixes of the name
+void Model::remove_name_prefixes(const string& name)
+{
+  for (string::size_type length = 1; length <= UNIQUE_STRING_PREFIX_SIZE && length <= name.size(); ++length) {
+    auto itr = name_prefixes.find(name.substr(0, length));
+    if (--itr->second == 0) {
+      name_prefixes.erase(itr);
+    }
+  }
+}
+
+// remove all of the dead agents at once
+void Model::flush_graveyard()
+{
+  if (graveyard.empty()) {
+    return;
+  }
+  
+  // Erase the top level agents directly, and let each group remove any of its dead
+  // members in a single walk.
+  auto itr = agent_components.begin();
+  while (itr != agent_components.end()) {
+    if (graveyard.count(*itr->first)) {
+      itr = agent_components.erase(itr);
+    } else {
+      itr->second->remove_components_if_present(graveyard);
+      ++itr;
+    }
+  }
+  
+  // Take them out of our sim objects as well.
+  for (auto &name : graveyard) {
+    unindex_component(name);
+    auto object = objects.find(&name);
+    if (object != objects.end()) {
+      coarse_agents.erase(object->second.get());
+    }
+    if (objects.erase(&name)) {
+      remove_name_prefixes(name);
+    }
+  }
+  graveyard.clear();
 }
 
@@ -12,6 +12,12 @@
  and AgentComponent_factory.
  Finally, it keeps the system's time.
  
+ Each Model is a whole world, and one program can hold many of them. Objects find
+ their Model by calling Model::get(), which returns the one made current for the
+ calling thread by a Model::Scope, or else the program's main Model. Worlds share
+ no mutable state, so each can run on its own thread, with its messages going to
+ its own output stream.
+ 
  Controller tells Model what to do; Model in turn tells the objects what do, and
  when asked to do so by an object, tells all the Views whenever anything changes that might be relevant.
  Model also provides facilities for looking up objects given their name.
@@ -20,9 +26,15 @@
  
  */
 
+#include "Agent_handle.h"
+#include "Utility.h"
+
+#include <functional>
+#include <iosfwd>
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -32,19 +44,40 @@ class AgentComponent;
 class AgentIndividual;
 class AgentGroup;
 class View;
+class Spatial_index;
 struct Point;
 class Model;
 
 class Model {
+public:
   
-  // create the initial objects
-	Model();
+  // create a world with the initial objects, which writes its messages to output
+  Model();
+  explicit Model(std::ostream& output_);
   
-public:
+  ~Model();
   
-  // return singleton instance of model
+  // return the current Model of the calling thread
   static Model& get();
   
+  // While a Scope exists, its Model is the current one for the thread that made it.
+  class Scope {
+  public:
+    explicit Scope(Model& model);
+    ~Scope();
+  private:
+    Model* previous;
+    Scope(const Scope&)             = delete;
+    Scope& operator= (const Scope&) = delete;
+  };
+  
+  // the stream the objects in this world write their messages to; views still draw to
+  // cout, so a world run off the main thread should have no views attached
+  std::ostream& out() const {return *output;}
+  
+  // the next number in this world's sequence for objects that take turns by chance
+  int next_chance_number() {return chance_number++;}
+  
 	// return the current time
 	int get_time() {return time;}
   
@@ -61,7 +94,7 @@ public:
 	// will throw Error("Structure not found!") if no structure of that name
 	std::shared_ptr<Structure> get_structure_ptr(const std::string& name) const;
 	// returns the closest structure to the provided agent
-	std::shared_ptr<Structure> closest_structure(std::shared_ptr<Sim_object> object) const;
+	std::shared_ptr<Structure> closest_structure(const Sim_object& object) const;
   
 	// is there an agent component with this name?
 	bool is_agent_component_present(const std::string& name) const;
@@ -69,6 +102,8 @@ public:
   bool is_agent_component_in_group(std::shared_ptr<AgentComponent>) const;
   // are these two agent components in the same group?
   bool are_in_same_group(const std::string &a1, const std::string &a2) const;
+  // the name of the outermost group holding the agent component, empty if it isn't in one
+  std::string get_group_name(const std::string& name) const;
   
   // add a new individual agent, throws if name is in use
   void add_new_agent(std::shared_ptr<AgentIndividual>);
@@ -76,42 +111,79 @@ public:
   void add_existing_agent_component(std::shared_ptr<AgentComponent> component);
 	// add a new agent component to the model; assumes it doesn't exist already
 	void add_new_agent_component(std::shared_ptr<AgentComponent>);
+  // add many new objects at once, as when loading a scenario. agents holds every new
+  // individual, and components holds the new top level agent components (ungrouped
+  // agents and groups). Names must be new but need not have unique prefixes; throws
+  // before adding anything if one is taken. Views hear about the objects once they are all in.
+  void add_objects_in_bulk(const std::vector<std::shared_ptr<Structure>>& new_structures,
+                           const std::vector<std::shared_ptr<AgentIndividual>>& new_agents,
+                           const std::vector<std::shared_ptr<AgentComponent>>& new_components);
   // add an existing agent component to an existing group
   void add_agent_component_to_group(std::shared_ptr<AgentComponent> component,
                                     std::shared_ptr<AgentComponent> group);
   
-  // removes an agent from Sim_objects and AgentComponents; throws if doesn't exist
+  // queues a dead agent for removal from Sim_objects and AgentComponents at the end of
+  // the current update; assumes the agent exists
   void remove_agent(const std::string& name);
   // removes an agent component
   void remove_agent_component(const std::string& name);
+  // take an individual agent out of the model without a trace, as when it moves
+  // to another Model; throws Error if there is no such agent
+  std::shared_ptr<AgentIndividual> take_out_agent(const std::string& name);
   // removes the specified agent component, assumes it exists
   void remove_agent_component_from_group(std::shared_ptr<AgentComponent> component,
                                          std::shared_ptr<AgentComponent> group);
   
 	// will throw Error("AgentComponent not found!") if no agent of that name
 	std::shared_ptr<AgentComponent> get_agent_comp_ptr(const std::string& name) const;
+  // a handle to the named agent component, one that never resolves if there is none
+  Agent_handle get_agent_handle(const std::string& name) const;
+  // the agent component the handle refers to, or nullptr if it has left the model
+  AgentComponent* get_agent(Agent_handle handle) const
+    { return handle.index >= 0 && handle.index < int(agent_slots.size()) &&
+        agent_slots[handle.index].generation == handle.generation ?
+        agent_slots[handle.index].component.get() : nullptr; }
 	// returns the closest agent to the provided agent (not the same agent)
-	std::shared_ptr<AgentComponent> closest_agent_in_range_not_in_group(std::shared_ptr<Sim_object> object,
+	std::shared_ptr<AgentComponent> closest_agent_in_range_not_in_group(const Sim_object& object,
                                                                       double range) const;
   // find all agents in the given range around the given object
-  std::shared_ptr<AgentComponent> find_agents_in_range(std::shared_ptr<Sim_object> center,
+  std::shared_ptr<AgentComponent> find_agents_in_range(const Sim_object& center,
                                                        double range) const;
   
+  // call the function on every object in name order; it must not add or remove objects
+  void for_each_object(std::function<void (const std::shared_ptr<Sim_object>&)> func) const;
+  
 	// tell all objects to describe themselves to the console
 	void describe() const;
 	// increment the time, and tell all objects to update themselves
 	void update();
+  
+  // Level of detail: with an interval above 1, agents that no view can see and that
+  // are far from every other agent are only brought up to date every interval ticks.
+  // They still go through every tick, so arrival ticks match the full schedule and
+  // food totals only differ by when a coarse peasant's collection reads the farm,
+  // which is up to interval - 1 ticks late; meanwhile their state, and their
+  // messages, lag by up to that much. Throws Error if the interval isn't positive.
+  void set_lod_interval(int interval);
+  // bring every agent on the coarse schedule up to the current time
+  void synchronize();
+  // bring the agents on the coarse schedule that could come within range of the
+  // location before the next classification up to the current time, and put them
+  // back on the full schedule
+  void end_coarse_near(Point location, double range);
 	
 	/* View services */
   
 	// Attaching a View adds it to the container and causes it to be updated
   // with all current objects'location (or other state information.
+  // A View that follows an object only gets the locations inside its area.
 	void attach(std::shared_ptr<View>);
 	// Detach the View by discarding the supplied pointer from the container of Views
   // - no updates sent to it thereafter.
 	void detach(std::shared_ptr<View>);
   
-  // notify the views about an object's location
+  // notify the views about an object's location; views following an object
+  // only hear about locations entering, inside, or leaving their area
 	void notify_location(const std::string& name, Point location);
   // notify the views about an object's health
   void notify_health(const std::string& name, int health);
@@ -125,20 +197,93 @@ public:
   void notify_end_attack(const std::string& name);
   
 private:
-  using Objects_t = std::map<std::string, std::shared_ptr<Sim_object>>;
-  using Structures_t = std::map<std::string, std::shared_ptr<Structure>>;
-  using AgentComponents_t = std::map<std::string, std::shared_ptr<AgentComponent>>;
+  // Containers are keyed by a pointer to the name held by the object itself.
+  using Objects_t = std::map<const std::string*, std::shared_ptr<Sim_object>, Name_ptr_less>;
+  using Structures_t = std::map<const std::string*, std::shared_ptr<Structure>, Name_ptr_less>;
+  using AgentComponents_t = std::map<const std::string*, std::shared_ptr<AgentComponent>, Name_ptr_less>;
+  
+  // the square around a followed object that a view wants locations from
+  struct View_area;
+  // a null area means the view wants every location
+  using Views_t = std::map<std::shared_ptr<View>, std::unique_ptr<View_area>>;
+  using Prefix_counts_t = std::unordered_map<std::string, int>;
+  using Component_index_t = std::unordered_map<const std::string*, int, Name_ptr_hash, Name_ptr_equal>;
+  
+  // an entry in the agent table; the generation changes each time the slot is freed
+  struct Agent_slot {
+    std::shared_ptr<AgentComponent> component;
+    unsigned generation;
+  };
   
   // Insert into containters w/o broadcasting
   void insert_structure(std::shared_ptr<Structure>);
   void insert_new_agent(std::shared_ptr<AgentIndividual>);
   
+  // add the component to the agent table, or take it out
+  void index_component(std::shared_ptr<AgentComponent> component);
+  void unindex_component(const std::string& name);
+  
+  // lay out the structure coordinates for closest_structure
+  void index_structures();
+  
+  // work out the distances from the location to every top level agent at once
+  void fill_range_batch(Point location, double range) const;
+  
+  // count or uncount the short prefixes of an object name for is_name_in_use
+  void add_name_prefixes(const std::string& name);
+  void remove_name_prefixes(const std::string& name);
+  
+  // remove every agent queued by remove_agent, walking each group at most once
+  void flush_graveyard();
+  
+  // pick which agents go on or come off the coarse schedule
+  void classify_lod();
+  // is the object out of sight of every view and away from every other agent?
+  bool is_isolated(const Sim_object& object) const;
+  
+  // the followed object moved, send the view whatever entered or left its area
+  void move_view_area(View& view, View_area& area, Point new_center);
+  
   int time;
+  std::ostream* output;
+  int chance_number;
   Objects_t objects;
   Structures_t structures;
+  // structure names and coordinates in name order, for batch distance queries
+  std::vector<const std::string*> structure_names;
+  std::vector<double> structure_xs;
+  std::vector<double> structure_ys;
   AgentComponents_t agent_components;
+  // the top level agents in name order, with a null individual for a group, and their
+  // distances from the location of the last range query
+  struct Range_batch {
+    std::vector<AgentIndividual*> individuals;
+    std::vector<double> xs, ys;
+    std::vector<double> squared_distances;
+    std::vector<unsigned char> in_range;
+  };
+  mutable Range_batch range_batch;
+  // every agent and group, wherever it is in the group tree, in a table of slots
+  // that handles refer to, and indexed by name
+  std::vector<Agent_slot> agent_slots;
+  std::vector<int> free_agent_slots;
+  Component_index_t component_index;
+  
+  // number of object names starting with each one and two character prefix
+  Prefix_counts_t name_prefixes;
+  
+  // names of dead agents waiting to be removed at the end of the tick
+  std::set<std::string> graveyard;
+  
+  // ticks between updates of agents on the coarse schedule, 1 for none
+  int lod_interval;
+  // agents on the coarse schedule, with the last tick each has been brought up to
+  std::unordered_map<Sim_object*, int> coarse_agents;
+  
+  // last known location of every object, for views that follow an object
+  std::unique_ptr<Spatial_index> spatial_index;
   
-  std::set<std::shared_ptr<View>> views;
+  Views_t views;
   
 	// disallow copy/move construction or assignment
 	Model(const Model&)             = delete;
@@ -1,7 +1,9 @@
 #include "Moving_object.h"
 #include <cmath>
+#include <cstdlib>
 
 using std::fabs;
+using std::llabs;
 
 // Tell this object to start moving to location in_destination
 // If it is already at the destination and moving, it stops;
@@ -9,7 +11,7 @@ using std::fabs;
 // Otherwise, it starts moving, advancing by delta on each update call.
 void Moving_object::start_moving(Point in_destination)
 {
-	if(location == in_destination) {
+	if(location == Coordinates(in_destination)) {
 		if(moving) {
 			stop_moving();
     }
@@ -24,7 +26,7 @@ void Moving_object::start_moving(Point in_destination)
 // change the speed by recomputing the delta if we are moving
 void Moving_object::set_speed(double in_speed)
 {
-	speed = in_speed;
+	speed = to_coordinate(in_speed);
 	// recompute the delta to get to the same destination
 	if(moving)
 		compute_delta();
@@ -35,8 +37,11 @@ void Moving_object::set_speed(double in_speed)
 void Moving_object::stop_moving()
 {
 	moving = false;
-	delta = Cartesian_vector();
-	destination = Point();
+	delta = Coordinates();
+	destination = Coordinates();
+#if defined(FIXED_POINT_AGENTS)
+	remaining = 0;
+#endif
 }
 
 // If the destination is within one delta step away, the object has arrived.
@@ -44,18 +49,87 @@ void Moving_object::stop_moving()
 // Otherwise, add the delta to the location, and return false.
 bool Moving_object::update_location()
 {
-	Cartesian_vector diff = destination - location;
-	if ((fabs(diff.delta_x) <= fabs(delta.delta_x)) && (fabs(diff.delta_y) <= fabs(delta.delta_y))) {
+#if defined(FIXED_POINT_AGENTS)
+	if (remaining <= speed) {
+		location = destination;
+		stop_moving();
+		return true;
+	}
+	remaining -= speed;
+	location.x += delta.x;
+	location.y += delta.y;
+	return false;
+#else
+	Coordinate_t diff_x = destination.x - location.x;
+	Coordinate_t diff_y = destination.y - location.y;
+	if ((fabs(diff_x) <= fabs(delta.x)) && (fabs(diff_y) <= fabs(delta.y))) {
 		location = destination;
 		stop_moving();
 		return true;
   }
-	location = location + delta;
+	location.x += delta.x;
+	location.y += delta.y;
 	return false;
+#endif
+}
+
+// Take the same steps as that many update_location calls would, stopping on arrival.
+int Moving_object::update_location(int max_steps)
+{
+	for (int step = 1; step <= max_steps; ++step) {
+		if (update_location())
+			return step;
+	}
+	return max_steps;
 }
 
+#if defined(FIXED_POINT_AGENTS)
+// the largest root with root * root <= n
+static unsigned long long integer_sqrt(unsigned long long n)
+{
+	unsigned long long root = 0;
+	unsigned long long bit = 1ULL << 62;
+	while (bit > n)
+		bit >>= 2;
+	while (bit) {
+		if (n >= root + bit) {
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+			root >>= 1;
+		bit >>= 2;
+	}
+	return root;
+}
+
+// legs are measured in 1/1024ths, so that the squares of their sides fit in 64 bits
+const int LENGTH_SHIFT = 31;
+
+// measure a new leg from the current location with an integer square root, and work
+// out the increments that cover it at the current speed
+void Moving_object::compute_delta()
+{
+	Coordinate_t diff_x = destination.x - location.x;
+	Coordinate_t diff_y = destination.y - location.y;
+	unsigned long long length_x = llabs(diff_x) >> LENGTH_SHIFT;
+	unsigned long long length_y = llabs(diff_y) >> LENGTH_SHIFT;
+	Coordinate_t length = Coordinate_t(integer_sqrt(length_x * length_x + length_y * length_y));
+	remaining = length << LENGTH_SHIFT;
+	delta = Coordinates();
+	// a leg no longer than one update is done on the first one, without stepping
+	if (speed < remaining) {
+		// diff * speed / length, taken in two parts so that neither product overflows
+		Coordinate_t length_speed = speed >> LENGTH_SHIFT;
+		delta.x = diff_x / length * length_speed + diff_x % length * length_speed / length;
+		delta.y = diff_y / length * length_speed + diff_y % length * length_speed / length;
+	}
+}
+#else
 // use the Geometry operators to compute the delta change in x and y per update
 void Moving_object::compute_delta()
 {
-	delta = (destination - location) * (speed / cartesian_distance(destination, location));
+	Point from = location.get(), to = destination.get();
+	delta = (to - from) * (speed / cartesian_distance(to, from));
 }
+#endif
@@ -3,26 +3,57 @@
 
 #include "Geometry.h"
 
+#include <cmath>
+
 /* Moving_object encapsulates the calculations needed to make an object move
  from one point to another, moving a specified distance on each update_location call.
+ Building with COMPACT_AGENTS stores the coordinates and speed as floats, which halves
+ the state every agent updates on each tick at the cost of some precision.
+ Building with FIXED_POINT_AGENTS stores them as whole numbers of units of 2^-41 instead,
+ and moves them with integer arithmetic only, so positions come out the same whatever
+ the compiler, flags or vector units. Coordinates must then stay within +/- 1,000,000.
  */
 
+#if defined(FIXED_POINT_AGENTS) && defined(COMPACT_AGENTS)
+#error "Use at most one of FIXED_POINT_AGENTS and COMPACT_AGENTS"
+#endif
+
+#if defined(FIXED_POINT_AGENTS)
+using Coordinate_t = long long;
+// stored coordinates count units of 1 / FIXED_POINT_SCALE, which is 2 to the 41st
+const double FIXED_POINT_SCALE = 2199023255552.0;
+inline Coordinate_t to_coordinate(double value)
+	{return std::llround(value * FIXED_POINT_SCALE);}
+inline double from_coordinate(Coordinate_t value)
+	{return value / FIXED_POINT_SCALE;}
+#else
+#if defined(COMPACT_AGENTS)
+using Coordinate_t = float;
+#else
+using Coordinate_t = double;
+#endif
+inline Coordinate_t to_coordinate(double value)
+	{return Coordinate_t(value);}
+inline double from_coordinate(Coordinate_t value)
+	{return value;}
+#endif
+
 class Moving_object {
 public:
 	Moving_object() :
     moving(false) {}
 	Moving_object(Point init_location, double init_speed) :
-    moving(false), location(init_location), speed(init_speed) {}
+    location(init_location), speed(to_coordinate(init_speed)), moving(false) {}
   
 	// readers
 	bool is_currently_moving() const
     {return moving;}
 	Point get_current_location() const
-    {return location;}
+    {return location.get();}
 	double get_current_speed() const
-    {return speed;}
+    {return from_coordinate(speed);}
 	Point get_current_destination() const
-    {return destination;}
+    {return destination.get();}
 	
 	// Tell this object to start moving to location destination.
 	// If it is already at the destination and moving, it stops;
@@ -36,13 +67,31 @@ public:
 	// update this object's location using current location, speed, and destination
 	// returns true if arrived at destination, false if not
 	bool update_location();
+	// do up to max_steps updates, stopping early on arrival;
+	// returns the number of updates done
+	int update_location(int max_steps);
   
 private:
-	bool moving;			// true if this object is moving
-	Point location;			// current location
-	double speed;			// distance moved per update
-	Point destination;		// destination to move to
-	Cartesian_vector delta;	// x, y increments per update
+	// a pair of coordinates, kept in the stored representation
+	struct Coordinates {
+		Coordinates() : x(0), y(0) {}
+		Coordinates(Point p) : x(to_coordinate(p.x)), y(to_coordinate(p.y)) {}
+		Coordinates(Cartesian_vector v) : x(to_coordinate(v.delta_x)), y(to_coordinate(v.delta_y)) {}
+		Point get() const
+			{return Point(from_coordinate(x), from_coordinate(y));}
+		bool operator== (const Coordinates& rhs) const
+			{return x == rhs.x && y == rhs.y;}
+		Coordinate_t x, y;
+	};
+	
+	Coordinates location;		// current location
+	Coordinate_t speed;		// distance moved per update
+	Coordinates destination;	// destination to move to
+#if defined(FIXED_POINT_AGENTS)
+	Coordinate_t remaining = 0;	// how much of the current leg is left
+#endif
+	Coordinates delta;		// x, y increments per update
+	bool moving;			// true if this object is moving; last, so a derived class can use the padding after it
 	
 	// helpers
 	void compute_delta();
@@ -11,7 +11,7 @@
 #include <iostream>
 
 using std::string;
-using std::cout; using std::endl;
+using std::endl;
 using std::shared_ptr;
 
 const double INITIAL_CARRYING_FOOD = 0.0;
@@ -26,7 +26,26 @@ Peasant::Peasant(const string& in_name, Point in_location) :
 void Peasant::update()
 {
   AgentIndividual::update();
-  
+  work();
+}
+
+// run the working steps over that many ticks, taking each leg of a trip in one go;
+// food is collected and deposited on the same ticks as it would be with update
+void Peasant::update_coarse(int ticks)
+{
+  while (ticks > 0 && is_alive()) {
+    int moved = move_for(ticks);
+    ticks -= moved > 0 ? moved : 1;
+    work();
+    if (state == NOT_WORKING && !is_moving()) {
+      return;
+    }
+  }
+}
+
+// do one tick of the working cycle, after any movement for that tick
+void Peasant::work()
+{
   if (!is_alive() || state == NOT_WORKING) {
     return;
   }
@@ -41,14 +60,14 @@ void Peasant::update()
     food_in_hand += withdrawl;
     
     if (withdrawl > 0.0) {
-      cout << get_name() << ": Collected " << withdrawl << endl;
+      Model::get().out() << get_name() << ": Collected " << withdrawl << endl;
       state = OUTBOUND;
       AgentIndividual::move_to(destination->get_location());
       
       // Let the Model know we've collected food.
       Model::get().notify_amount(get_name(), food_in_hand);
     } else {
-      cout << get_name() << ": Waiting " << endl;
+      Model::get().out() << get_name() << ": Waiting " << endl;
     }
   } else if (state == OUTBOUND &&
              !is_moving() &&
@@ -56,7 +75,7 @@ void Peasant::update()
     state = DEPOSITING;
   } else if (state == DEPOSITING) {
     destination->deposit(food_in_hand);
-    cout << get_name() << ": Deposited " << food_in_hand << endl;
+    Model::get().out() << get_name() << ": Deposited " << food_in_hand << endl;
     food_in_hand = INITIAL_CARRYING_FOOD;
     AgentIndividual::move_to(source->get_location());
     state = INBOUND;
@@ -69,7 +88,7 @@ void Peasant::update()
 void Peasant::stop_working()
 {
   if (state != NOT_WORKING) {
-    cout << get_name() << ": I'm stopping work" << endl;
+    Model::get().out() << get_name() << ": I'm stopping work" << endl;
     state = NOT_WORKING;
     destination = source = nullptr;
   }
@@ -128,18 +147,18 @@ void Peasant::accept_blessing(int blessing_strength, shared_ptr<AgentIndividual>
 // output information about the current state
 void Peasant::describe() const
 {
-  cout << "Peasant ";
+  Model::get().out() << "Peasant ";
   AgentIndividual::describe();
-  cout << "   Carrying " << food_in_hand << endl;
+  Model::get().out() << "   Carrying " << food_in_hand << endl;
   
   if (state == OUTBOUND) {
-    cout << "   Outbound to destination " << destination->get_name() << endl;
+    Model::get().out() << "   Outbound to destination " << destination->get_name() << endl;
   } else if (state == INBOUND) {
-    cout << "   Inbound to source " << source->get_name() << endl;
+    Model::get().out() << "   Inbound to source " << source->get_name() << endl;
   } else if (state == COLLECTING) {
-    cout << "   Collecting at source " << source->get_name() << endl;
+    Model::get().out() << "   Collecting at source " << source->get_name() << endl;
   } else if (state == DEPOSITING) {
-    cout << "   Depositing at destination " << destination->get_name() << endl;
+    Model::get().out() << "   Depositing at destination " << destination->get_name() << endl;
   }
 }
 
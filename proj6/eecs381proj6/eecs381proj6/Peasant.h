@@ -24,6 +24,9 @@ public:
   
 	// implement Peasant behavior
 	void update() override;
+  
+  // run the working steps over that many ticks, taking each leg of a trip in one go
+  void update_coarse(int ticks) override;
 	
 	// overridden to suspend working behavior
   void move_to(Point dest) override;
@@ -41,6 +44,9 @@ public:
 	// output information about the current state
 	void describe() const override;
   
+  std::string get_type() const override
+    { return "Peasant"; }
+  
   // ask model to broadcast our current state
   void broadcast_current_state() override;
   
@@ -59,6 +65,8 @@ private:
   Peasant_state_e state;
   
   void stop_working();
+  // do one tick of the working cycle, after any movement for that tick
+  void work();
 };
 
 #endif
@@ -0,0 +1,92 @@
+#ifndef PERFECT_HASH_MAP_H_
+#define PERFECT_HASH_MAP_H_
+
+/*
+ 
+ * Perfect_hash_map class template *
+ 
+ A read-only map for a small fixed set of string keys, such as command words.
+ On construction it searches for a hash seed that gives every key its own slot,
+ so a lookup is one hash of the word and at most one string comparison.
+ 
+*/
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+template <typename T>
+class Perfect_hash_map {
+public:
+  Perfect_hash_map() :
+    slots(1), mask{0}, seed{0}
+  {}
+  
+  // lay out the entries, doubling the table until a seed with no collisions is found
+  explicit Perfect_hash_map(const std::map<std::string, T>& entries)
+  {
+    std::size_t size = 1;
+    while (size < entries.size() * 2) {
+      size *= 2;
+    }
+    
+    while (true) {
+      for (seed = 0; seed < MAX_SEEDS_PER_SIZE; ++seed) {
+        if (try_layout(entries, size)) {
+          return;
+        }
+      }
+      size *= 2;
+    }
+  }
+  
+  // return a pointer to the value for the key, or nullptr if it isn't one of the keys
+  const T* find(const std::string& key) const
+  {
+    const Slot& slot = slots[hash(key, seed) & mask];
+    return slot.used && slot.key == key ? &slot.value : nullptr;
+  }
+  
+private:
+  struct Slot {
+    std::string key;
+    T value;
+    bool used = false;
+  };
+  
+  static const std::size_t MAX_SEEDS_PER_SIZE = 64;
+  
+  // FNV-1a, with the seed folded into the starting value
+  static std::size_t hash(const std::string& key, std::size_t seed)
+  {
+    std::size_t h = 2166136261u ^ (seed * 16777619u);
+    for (char c : key) {
+      h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return h ^ (h >> 15);
+  }
+  
+  // place every entry with the current seed, false if two of them collide
+  bool try_layout(const std::map<std::string, T>& entries, std::size_t size)
+  {
+    slots.assign(size, Slot());
+    mask = size - 1;
+    for (auto &entry : entries) {
+      Slot& slot = slots[hash(entry.first, seed) & mask];
+      if (slot.used) {
+        return false;
+      }
+      slot.key = entry.first;
+      slot.value = entry.second;
+      slot.used = true;
+    }
+    return true;
+  }
+  
+  std::vector<Slot> slots;
+  std::size_t mask;
+  std::size_t seed;
+};
+
+#endif
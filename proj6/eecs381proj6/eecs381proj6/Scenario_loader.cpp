@@ -0,0 +1,220 @@
+#include "Scenario_loader.h"
+
+#include "AgentComponent.h"
+#include "AgentGroup.h"
+#include "AgentIndividual.h"
+#include "Agent_factory.h"
+#include "Geometry.h"
+#include "Model.h"
+#include "Structure.h"
+#include "Structure_factory.h"
+#include "Utility.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::istream; using std::istringstream; using std::ostringstream;
+using std::string; using std::map; using std::vector;
+using std::shared_ptr; using std::make_shared;
+using std::setw; using std::setfill;
+using std::mt19937;
+using std::to_string;
+using std::ceil; using std::sqrt;
+
+const string SEED_KEYWORD = "seed";
+const string STRUCTURES_KEYWORD = "structures";
+const string AGENTS_KEYWORD = "agents";
+const string GROUPS_KEYWORD = "groups";
+const string UNIFORM_PLACEMENT = "uniform";
+const string GRID_PLACEMENT = "grid";
+const string GROUP_NAME_SUFFIX = "Group";
+const char COMMENT_CHAR = '#';
+const int NAME_NUMBER_WIDTH = 6;
+const unsigned int DEFAULT_SEED = 1;
+const double GENERATOR_RANGE = 4294967296.0; // 2^32, mt19937 gives 32 bit values
+
+// Everything read from a scenario, waiting to be added to the Model.
+class Scenario {
+public:
+  explicit Scenario(unsigned int seed_offset_) :
+    seed_offset{seed_offset_}, generator{DEFAULT_SEED + seed_offset_} {}
+  
+  // read one line of the scenario, throws Error if it is malformed
+  void read_line(const string& line);
+  
+  // add all of the objects to the Model at once, returns how many there were
+  int add_to_model();
+  
+private:
+  // how to place objects and the rectangle to place them in
+  struct Area_t {
+    string placement;
+    Point lower_left, upper_right;
+  };
+  
+  // read the placement and rectangle
+  Area_t read_area(istream& is);
+  // return count locations within the area
+  vector<Point> place(const Area_t& area, int count);
+  // return the next unused name for an object of this type
+  string next_object_name(const string& type);
+  // return the next unused name for a group of this type
+  string next_group_name(const string& type);
+  
+  unsigned int seed_offset;
+  mt19937 generator;
+  map<string, int> name_counts;
+  vector<shared_ptr<Structure>> structures;
+  vector<shared_ptr<AgentIndividual>> agents;
+  vector<shared_ptr<AgentComponent>> components;
+};
+
+// read the whole scenario before adding anything, so a bad line leaves the Model untouched
+int load_scenario(istream& is, unsigned int seed_offset)
+{
+  Scenario scenario(seed_offset);
+  string line;
+  int line_number = 0;
+  while (getline(is, line)) {
+    ++line_number;
+    try {
+      scenario.read_line(line);
+    } catch (Error& e) {
+      throw Error("Scenario line " + to_string(line_number) + ": " + e.msg);
+    }
+  }
+  return scenario.add_to_model();
+}
+
+void Scenario::read_line(const string& line)
+{
+  istringstream is(line.substr(0, line.find(COMMENT_CHAR)));
+  string keyword;
+  if (!(is >> keyword)) {
+    return;
+  }
+  
+  int number = 1, count;
+  string type;
+  if (keyword == SEED_KEYWORD) {
+    unsigned int seed;
+    if (!(is >> seed)) {
+      throw Error("Expected a seed!");
+    }
+    generator.seed(seed + seed_offset);
+    return;
+  } else if (keyword == GROUPS_KEYWORD) {
+    if (!(is >> number) || number < 0) {
+      throw Error("Expected a number of groups!");
+    }
+  } else if (keyword != STRUCTURES_KEYWORD && keyword != AGENTS_KEYWORD) {
+    throw Error("Unrecognized keyword " + keyword + "!");
+  }
+  if (!(is >> count) || count < 0) {
+    throw Error("Expected a count!");
+  }
+  if (!(is >> type)) {
+    throw Error("Expected a type!");
+  }
+  
+  Area_t area = read_area(is);
+  
+  if (keyword == STRUCTURES_KEYWORD) {
+    for (auto location : place(area, count)) {
+      structures.push_back(create_structure(next_object_name(type), type, location));
+    }
+    return;
+  }
+  
+  // every group is placed in the same rectangle
+  for (int group_number = 0; group_number < number; ++group_number) {
+    shared_ptr<AgentGroup> group;
+    if (keyword == GROUPS_KEYWORD) {
+      group = make_shared<AgentGroup>(next_group_name(type));
+      components.push_back(group);
+    }
+    for (auto location : place(area, count)) {
+      auto agent = create_agent(next_object_name(type), type, location);
+      agents.push_back(agent);
+      if (group) {
+        group->add_component(agent);
+      } else {
+        components.push_back(agent);
+      }
+    }
+  }
+}
+
+int Scenario::add_to_model()
+{
+  Model::get().add_objects_in_bulk(structures, agents, components);
+  return static_cast<int>(structures.size() + agents.size());
+}
+
+Scenario::Area_t Scenario::read_area(istream& is)
+{
+  Area_t area;
+  if (!(is >> area.placement)) {
+    throw Error("Expected a placement!");
+  }
+  if (area.placement != UNIFORM_PLACEMENT && area.placement != GRID_PLACEMENT) {
+    throw Error("Unrecognized placement " + area.placement + "!");
+  }
+  if (!(is >> area.lower_left.x >> area.lower_left.y >> area.upper_right.x >> area.upper_right.y)) {
+    throw Error("Expected a rectangle!");
+  }
+  return area;
+}
+
+vector<Point> Scenario::place(const Area_t& area, int count)
+{
+  double x1 = area.lower_left.x, y1 = area.lower_left.y;
+  double x2 = area.upper_right.x, y2 = area.upper_right.y;
+  
+  vector<Point> locations;
+  locations.reserve(count);
+  if (area.placement == UNIFORM_PLACEMENT) {
+    // scale the raw generator output ourselves, so a seed gives the same world everywhere
+    for (int i = 0; i < count; ++i) {
+      double x = x1 + (x2 - x1) * (generator() / GENERATOR_RANGE);
+      double y = y1 + (y2 - y1) * (generator() / GENERATOR_RANGE);
+      locations.push_back(Point(x, y));
+    }
+  } else {
+    int columns = count ? int(ceil(sqrt(double(count)))) : 1;
+    int rows = (count + columns - 1) / columns;
+    double dx = columns > 1 ? (x2 - x1) / (columns - 1) : 0.0;
+    double dy = rows > 1 ? (y2 - y1) / (rows - 1) : 0.0;
+    for (int i = 0; i < count; ++i) {
+      locations.push_back(Point(x1 + (i % columns) * dx, y1 + (i / columns) * dy));
+    }
+  }
+  return locations;
+}
+
+string Scenario::next_object_name(const string& type)
+{
+  ostringstream name;
+  do {
+    name.str("");
+    name << type << setw(NAME_NUMBER_WIDTH) << setfill('0') << ++name_counts[type];
+  } while (Model::get().object_fullname_exists(name.str()));
+  return name.str();
+}
+
+string Scenario::next_group_name(const string& type)
+{
+  string group_type = type + GROUP_NAME_SUFFIX;
+  string name;
+  do {
+    name = group_type + to_string(++name_counts[group_type]);
+  } while (Model::get().object_fullname_exists(name) || Model::get().is_agent_component_present(name));
+  return name;
+}
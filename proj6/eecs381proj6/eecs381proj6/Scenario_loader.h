@@ -0,0 +1,30 @@
+#ifndef SCENARIO_LOADER_H
+#define SCENARIO_LOADER_H
+
+/*
+ A scenario is a compact description of a large world, read one line at a time:
+ 
+   seed <n>
+   structures <count> <type> <placement> <x1> <y1> <x2> <y2>
+   agents <count> <type> <placement> <x1> <y1> <x2> <y2>
+   groups <number> <count> <type> <placement> <x1> <y1> <x2> <y2>
+ 
+ Each line creates count objects of the given type inside the rectangle from
+ (x1, y1) to (x2, y2). A groups line creates that number of groups, each holding
+ count new agents. Placement is either "uniform", for random locations from the
+ seeded generator, or "grid", for evenly spaced rows and columns. Blank lines and
+ anything after a # are ignored.
+ 
+ Objects are named after their type with a sequence number (Peasant000001,
+ SoldierGroup1, ...), skipping any names already in the Model.
+ */
+
+#include <iosfwd>
+
+// Read a scenario from the stream and add everything in it to the Model at once.
+// The seed offset is added to every seed, so one scenario can give many different
+// worlds. Throws Error naming the line if the scenario is malformed, in which case
+// nothing is added. Returns the number of objects created.
+int load_scenario(std::istream& is, unsigned int seed_offset = 0);
+
+#endif
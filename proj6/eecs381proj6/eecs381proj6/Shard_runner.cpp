@@ -0,0 +1,551 @@
+#include "Shard_runner.h"
+
+#include "AgentIndividual.h"
+#include "Agent_factory.h"
+#include "Geometry.h"
+#include "Ghost_agent.h"
+#include "Model.h"
+#include "Sim_object.h"
+#include "Structure.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using std::cout; using std::endl;
+using std::string; using std::map; using std::set; using std::vector;
+using std::istringstream; using std::ostringstream;
+using std::shared_ptr; using std::make_shared; using std::dynamic_pointer_cast;
+using std::make_pair;
+using std::setprecision;
+using std::numeric_limits;
+using std::sort; using std::upper_bound;
+
+// how close to a boundary an agent has to be to have a ghost on the other side;
+// more than any attack range plus a tick's movement on both sides
+const double GHOST_MARGIN = 20.0;
+const char HANDOFF_LINE = 'H';
+const char GHOST_LINE = 'G';
+const char DAMAGE_LINE = 'D';
+// the group name sent for an agent that isn't in one
+const string NO_GROUP = "-";
+// enough digits for a double to survive the trip
+const int MESSAGE_PRECISION = 17;
+// each region is a forked process, so an interactive command can't ask for thousands
+const int MAX_REGIONS = 64;
+
+// The strips, each from its boundary to the next; the outer two are open-ended.
+class Regions {
+public:
+  // cut the map so each strip starts with about the same number of objects
+  explicit Regions(int count);
+
+  int size() const
+    { return int(boundaries.size()) - 1; }
+  double lower(int region) const
+    { return boundaries[region]; }
+  double upper(int region) const
+    { return boundaries[region + 1]; }
+
+  // the region a point with this x is in
+  int region_of(double x) const;
+  // is a point with this x close enough to the region for it to see a ghost there?
+  bool is_near(int region, double x) const
+    { return x >= lower(region) - GHOST_MARGIN && x <= upper(region) + GHOST_MARGIN; }
+
+private:
+  vector<double> boundaries;
+};
+
+Regions::Regions(int count)
+{
+  vector<double> xs;
+  Model::get().for_each_object([&xs](const shared_ptr<Sim_object>& object)
+                               { xs.push_back(object->get_location().x); });
+  sort(xs.begin(), xs.end());
+
+  boundaries.push_back(-numeric_limits<double>::infinity());
+  for (int region = 1; region < count; ++region) {
+    boundaries.push_back(xs.empty() ? 0.0 : xs[xs.size() * region / count]);
+  }
+  boundaries.push_back(numeric_limits<double>::infinity());
+}
+
+int Regions::region_of(double x) const
+{
+  return int(upper_bound(boundaries.begin() + 1, boundaries.end() - 1, x) - (boundaries.begin() + 1));
+}
+
+// Messages are a length followed by that many bytes of lines.
+
+// send the whole message, throws Error if the other end has gone
+void write_message(int fd, const string& message)
+{
+  uint32_t length = uint32_t(message.size());
+  string buffer(reinterpret_cast<const char*>(&length), sizeof(length));
+  buffer += message;
+
+  const char* next = buffer.data();
+  size_t remaining = buffer.size();
+  while (remaining) {
+    ssize_t written = send(fd, next, remaining, MSG_NOSIGNAL);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      throw Error("Shard connection lost!");
+    }
+    next += written;
+    remaining -= written;
+  }
+}
+
+// read exactly that many bytes, returns false if the other end closed or failed first
+bool read_fully(int fd, char* buffer, size_t size)
+{
+  while (size) {
+    ssize_t got = read(fd, buffer, size);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got <= 0) {
+      return false;
+    }
+    buffer += got;
+    size -= got;
+  }
+  return true;
+}
+
+// read the next whole message, throws Error if the other end has gone
+string read_message(int fd)
+{
+  uint32_t length;
+  if (!read_fully(fd, reinterpret_cast<char*>(&length), sizeof(length))) {
+    throw Error("Shard connection lost!");
+  }
+  string message(length, '\0');
+  if (length && !read_fully(fd, &message[0], length)) {
+    throw Error("Shard connection lost!");
+  }
+  return message;
+}
+
+// The part of a worker process that runs one strip of the map.
+class Shard_worker {
+public:
+  // take every agent outside the strip out of this process's Model
+  Shard_worker(const Regions& regions_, int region_, int fd_);
+
+  // simulate, exchanging boundary traffic with the hub after each tick, then report
+  void run(int ticks);
+
+private:
+  bool owns(double x) const
+    { return regions.region_of(x) == region; }
+
+  // the live agents this worker owns
+  vector<shared_ptr<AgentIndividual>> owned_agents() const;
+
+  // hand off the agents that left, and list the ghosts and damage for the others
+  string collect();
+  // take in the ghosts, handoffs, and damage from the others
+  void apply(const string& message);
+  // what the strip holds now
+  string report() const;
+  
+  // the outermost group the owned agent is in, or NO_GROUP
+  const string& group_of(const string& name);
+
+  const Regions& regions;
+  int region;
+  int fd;
+  map<string, shared_ptr<Ghost_agent>> ghosts;
+  // groups of the agents that have come near a boundary so far
+  map<string, string> group_names;
+  int handoffs;
+};
+
+Shard_worker::Shard_worker(const Regions& regions_, int region_, int fd_) :
+  regions(regions_), region{region_}, fd{fd_}, handoffs{0}
+{
+  for (auto &agent : owned_agents()) {
+    if (!owns(agent->get_location().x)) {
+      Model::get().take_out_agent(agent->get_name());
+    }
+  }
+}
+
+void Shard_worker::run(int ticks)
+{
+  for (int tick = 0; tick <= ticks; ++tick) {
+    if (tick > 0) {
+      Model::get().update();
+    }
+    write_message(fd, collect());
+    apply(read_message(fd));
+  }
+  write_message(fd, report());
+}
+
+vector<shared_ptr<AgentIndividual>> Shard_worker::owned_agents() const
+{
+  vector<shared_ptr<AgentIndividual>> agents;
+  Model::get().for_each_object([&](const shared_ptr<Sim_object>& object) {
+    auto agent = dynamic_pointer_cast<AgentIndividual>(object);
+    if (agent && agent->is_alive() && !ghosts.count(agent->get_name())) {
+      agents.push_back(agent);
+    }
+  });
+  return agents;
+}
+
+string Shard_worker::collect()
+{
+  // Agents on the coarse schedule have to be where they really are.
+  Model::get().synchronize();
+
+  ostringstream os;
+  os << setprecision(MESSAGE_PRECISION);
+  for (auto &agent : owned_agents()) {
+    Point location = agent->get_location();
+    if (!owns(location.x)) {
+      Point destination = agent->is_moving() ? agent->get_current_destination() : location;
+      os << HANDOFF_LINE << ' ' << agent->get_name() << ' ' << agent->get_type() << ' '
+         << location.x << ' ' << location.y << ' ' << agent->get_health() << ' '
+         << agent->is_moving() << ' ' << destination.x << ' ' << destination.y << ' '
+         << group_of(agent->get_name()) << '\n';
+      group_names.erase(agent->get_name());
+      Model::get().take_out_agent(agent->get_name());
+      ++handoffs;
+    } else if (location.x - regions.lower(region) < GHOST_MARGIN ||
+               regions.upper(region) - location.x < GHOST_MARGIN) {
+      os << GHOST_LINE << ' ' << agent->get_name() << ' '
+         << location.x << ' ' << location.y << ' ' << group_of(agent->get_name()) << '\n';
+    }
+  }
+  for (auto &ghost : ghosts) {
+    if (int damage = ghost.second->take_damage()) {
+      os << DAMAGE_LINE << ' ' << ghost.first << ' ' << damage << '\n';
+    }
+  }
+  return os.str();
+}
+
+void Shard_worker::apply(const string& message)
+{
+  map<string, Point> ghost_locations;
+  vector<shared_ptr<AgentIndividual>> arrivals;
+  map<string, int> damages;
+  // the groups that arrivals and new ghosts join
+  map<string, string> joining;
+
+  istringstream is(message);
+  string line;
+  while (getline(is, line)) {
+    istringstream ls(line);
+    char kind;
+    string name, type, group;
+    Point location, destination;
+    int health, damage;
+    bool moving;
+    ls >> kind >> name;
+    if (kind == GHOST_LINE && ls >> location.x >> location.y >> group) {
+      ghost_locations[name] = location;
+      joining[name] = group;
+    } else if (kind == HANDOFF_LINE && ls >> type >> location.x >> location.y >> health >> moving
+               >> destination.x >> destination.y >> group) {
+      joining[name] = group;
+      group_names[name] = group;
+      auto agent = create_agent(name, type, location);
+      agent->set_health(health);
+      if (moving) {
+        agent->head_to(destination);
+      }
+      arrivals.push_back(agent);
+    } else if (kind == DAMAGE_LINE && ls >> damage) {
+      damages[name] += damage;
+    } else {
+      throw Error("Bad shard message!");
+    }
+  }
+
+  // Ghosts go away when their agent is no longer near, or has come over to us.
+  set<string> arrival_names;
+  for (auto &agent : arrivals)
+    arrival_names.insert(agent->get_name());
+  auto itr = ghosts.begin();
+  while (itr != ghosts.end()) {
+    if (!ghost_locations.count(itr->first) || arrival_names.count(itr->first)) {
+      Model::get().take_out_agent(itr->first);
+      itr = ghosts.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+
+  vector<shared_ptr<AgentIndividual>> new_agents = arrivals;
+  for (auto &ghost_location : ghost_locations) {
+    auto ghost = ghosts.find(ghost_location.first);
+    if (ghost != ghosts.end()) {
+      ghost->second->set_location(ghost_location.second);
+    } else if (!arrival_names.count(ghost_location.first) &&
+               !Model::get().object_fullname_exists(ghost_location.first)) {
+      auto new_ghost = make_shared<Ghost_agent>(ghost_location.first, ghost_location.second);
+      ghosts[ghost_location.first] = new_ghost;
+      new_agents.push_back(new_ghost);
+    }
+  }
+  vector<shared_ptr<AgentComponent>> new_components(new_agents.begin(), new_agents.end());
+  if (!new_agents.empty()) {
+    Model::get().add_objects_in_bulk({}, new_agents, new_components);
+  }
+  
+  // Every worker has its own copy of each group, so agents and ghosts from the same
+  // one still know not to attack each other.
+  for (auto &agent : new_agents) {
+    const string& group = joining[agent->get_name()];
+    if (group != NO_GROUP && Model::get().is_agent_component_present(group)) {
+      Model::get().add_agent_component_to_group(agent, Model::get().get_agent_comp_ptr(group));
+    }
+  }
+
+  // The agent may have died or moved on since it was hit.
+  for (auto &damage : damages) {
+    if (ghosts.count(damage.first) || !Model::get().is_agent_component_present(damage.first)) {
+      continue;
+    }
+    auto agent = dynamic_pointer_cast<AgentIndividual>(Model::get().get_agent_comp_ptr(damage.first));
+    if (agent && agent->is_alive()) {
+      agent->take_remote_hit(damage.second);
+    }
+  }
+}
+
+string Shard_worker::report() const
+{
+  int structures = 0;
+  double food = 0.0;
+  Model::get().for_each_object([&](const shared_ptr<Sim_object>& object) {
+    auto structure = dynamic_pointer_cast<Structure>(object);
+    if (structure && owns(structure->get_location().x)) {
+      ++structures;
+      food += structure->get_amount();
+    }
+  });
+  ostringstream os;
+  os << setprecision(MESSAGE_PRECISION)
+     << owned_agents().size() << ' ' << structures << ' ' << food << ' ' << handoffs << '\n';
+  return os.str();
+}
+
+const string& Shard_worker::group_of(const string& name)
+{
+  auto itr = group_names.find(name);
+  if (itr == group_names.end()) {
+    string group = Model::get().get_group_name(name);
+    itr = group_names.insert(make_pair(name, group.empty() ? NO_GROUP : group)).first;
+  }
+  return itr->second;
+}
+
+// The hub's side of the run: the workers, and which one owns each agent it has heard of.
+class Shard_hub {
+public:
+  explicit Shard_hub(const Regions& regions_) : regions(regions_) {}
+  // stop and reap any workers still running
+  ~Shard_hub();
+
+  // fork a worker for each region
+  void start(int ticks);
+  // pass each tick's boundary traffic along, then print the reports
+  void run(int ticks);
+
+private:
+  // send the lines from each worker on to where they belong
+  vector<string> route(const vector<string>& messages);
+
+  const Regions& regions;
+  vector<int> fds;
+  vector<pid_t> pids;
+  map<string, int> owners;
+};
+
+Shard_hub::~Shard_hub()
+{
+  for (int fd : fds)
+    close(fd);
+  // A worker that is still running has lost the hub, stop it rather than wait.
+  for (pid_t pid : pids) {
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+  }
+}
+
+void Shard_hub::start(int ticks)
+{
+  // Anything still buffered would be written again by every worker.
+  cout.flush();
+  for (int region = 0; region < regions.size(); ++region) {
+    int ends[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, ends) < 0) {
+      throw Error("Could not connect to shard!");
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+      close(ends[0]);
+      close(ends[1]);
+      throw Error("Could not start shard!");
+    }
+    if (pid == 0) {
+      // The worker keeps only its own end, and says nothing on the console.
+      for (int fd : fds)
+        close(fd);
+      close(ends[0]);
+      int null_fd = open("/dev/null", O_WRONLY);
+      dup2(null_fd, STDOUT_FILENO);
+      close(null_fd);
+      int status = 0;
+      try {
+        Shard_worker(regions, region, ends[1]).run(ticks);
+      } catch (...) {
+        status = 1;
+      }
+      // Leave without running destructors meant for the hub's process.
+      _exit(status);
+    }
+    close(ends[1]);
+    fds.push_back(ends[0]);
+    pids.push_back(pid);
+  }
+}
+
+void Shard_hub::run(int ticks)
+{
+  vector<string> messages(fds.size());
+  for (int tick = 0; tick <= ticks; ++tick) {
+    for (size_t region = 0; region < fds.size(); ++region)
+      messages[region] = read_message(fds[region]);
+    auto routed = route(messages);
+    for (size_t region = 0; region < fds.size(); ++region)
+      write_message(fds[region], routed[region]);
+  }
+
+  int total_agents = 0, total_structures = 0, total_handoffs = 0;
+  double total_food = 0.0;
+  for (int region = 0; region < regions.size(); ++region) {
+    istringstream is(read_message(fds[region]));
+    int agents, structures, handoffs;
+    double food;
+    if (!(is >> agents >> structures >> food >> handoffs)) {
+      throw Error("Bad shard message!");
+    }
+    cout << "Shard " << region << " from " << regions.lower(region) << " to " << regions.upper(region)
+         << ": " << agents << " agents, " << structures << " structures, "
+         << food << " food, " << handoffs << " handoffs" << endl;
+    total_agents += agents;
+    total_structures += structures;
+    total_food += food;
+    total_handoffs += handoffs;
+  }
+  cout << "Total: " << total_agents << " agents, " << total_structures << " structures, "
+       << total_food << " food, " << total_handoffs << " handoffs" << endl;
+
+  bool failed = false;
+  for (size_t region = 0; region < pids.size(); ++region) {
+    int status;
+    waitpid(pids[region], &status, 0);
+    close(fds[region]);
+    failed = failed || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+  }
+  pids.clear();
+  fds.clear();
+  if (failed) {
+    throw Error("Shard failed!");
+  }
+}
+
+// Handoffs go to the region the agent is now in, ghosts to every other region near
+// enough to see them, and damage to whoever owns the agent after this tick's handoffs.
+vector<string> Shard_hub::route(const vector<string>& messages)
+{
+  vector<string> routed(messages.size());
+  vector<string> damage_lines;
+  for (int sender = 0; sender < int(messages.size()); ++sender) {
+    istringstream is(messages[sender]);
+    string line;
+    while (getline(is, line)) {
+      istringstream ls(line);
+      char kind;
+      string name, type;
+      double x;
+      ls >> kind >> name;
+      line += '\n';
+      if (kind == HANDOFF_LINE && ls >> type >> x) {
+        int receiver = regions.region_of(x);
+        owners[name] = receiver;
+        routed[receiver] += line;
+      } else if (kind == GHOST_LINE && ls >> x) {
+        owners[name] = sender;
+        for (int region = 0; region < regions.size(); ++region) {
+          if (region != sender && regions.is_near(region, x)) {
+            routed[region] += line;
+          }
+        }
+      } else if (kind == DAMAGE_LINE) {
+        damage_lines.push_back(line);
+      } else {
+        throw Error("Bad shard message!");
+      }
+    }
+  }
+
+  for (auto &line : damage_lines) {
+    istringstream ls(line);
+    char kind;
+    string name;
+    ls >> kind >> name;
+    auto owner = owners.find(name);
+    if (owner != owners.end()) {
+      routed[owner->second] += line;
+    }
+  }
+  return routed;
+}
+
+void run_shards(int regions, int ticks)
+{
+  if (regions < 1) {
+    throw Error("Number of regions must be positive!");
+  }
+  if (regions > MAX_REGIONS) {
+    throw Error("Too many regions!");
+  }
+  if (ticks < 0) {
+    throw Error("Number of ticks must not be negative!");
+  }
+  // Bring every agent up to date, so the workers all start from the same time.
+  Model::get().synchronize();
+
+  Regions strips(regions);
+  Shard_hub hub(strips);
+  hub.start(ticks);
+  hub.run(ticks);
+}
@@ -0,0 +1,38 @@
+#ifndef SHARD_RUNNER_H_
+#define SHARD_RUNNER_H_
+
+/*
+ 
+ A sharded run splits the map into vertical strips holding about the same number
+ of objects, and simulates each strip in its own worker process. Each worker is
+ forked from this one, so it starts with a copy of the whole Model and then takes
+ out every agent outside its strip. Structures stay in every worker, since agents
+ anywhere may head for them.
+ 
+ After every tick the workers send this process, the hub, what has to cross a
+ boundary, over a local socket:
+ 
+   H <name> <type> <x> <y> <health> <moving> <x> <y> <group>   an agent that left the strip
+   G <name> <x> <y> <group>                                    an agent near the strip's edge
+   D <name> <damage>                                           hits taken by a ghost
+ 
+ The hub hands each agent over to the worker whose strip it is now in, and sends
+ the G lines to the workers on the other side of the boundary. There the agent
+ appears as a Ghost_agent that local agents can find and attack. Hits on a ghost
+ go back to the agent's owner, which applies them. Worker output is discarded;
+ at the end each worker reports what is in its strip and the hub prints it.
+ 
+ Handing an agent over carries its location, health, destination, and group,
+ which every worker has a copy of. A Peasant's work and a Warrior's target are
+ left behind, remote attackers can't be struck back, and blessings don't reach
+ across. Deposits and withdrawals at a structure only change the copy in the
+ worker that made them; the report counts each structure in the strip it stands in.
+ 
+*/
+
+// Simulate the world for that many ticks split over that many worker processes,
+// and print what each strip ended up with. The Model in this process is unchanged.
+// Throws Error if the arguments are out of range (at most 64 regions) or a worker fails.
+void run_shards(int regions, int ticks);
+
+#endif
@@ -23,6 +23,12 @@ public:
 	virtual void describe() const = 0;
 	virtual void update() = 0;
   
+  // can this object be left alone for a while when nothing observes or is near it?
+  virtual bool can_coarsen() const
+    {return false;}
+  // catch up on that many ticks at once, for objects on a coarse schedule
+  virtual void update_coarse(int ticks) {}
+  
 private:
 	std::string name;
 };
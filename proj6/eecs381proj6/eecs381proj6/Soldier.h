@@ -21,13 +21,16 @@ public:
 	Soldier(const std::string& name_, Point location_);
   
 	// Overrides AgentComponent's take_hit to counterattack when attacked.
-	void take_hit(int attack_strength, std::shared_ptr<AgentIndividual> attacker_ptr) override;
+	void take_hit(int attack_strength, AgentIndividual& attacker) override;
 	
 	// output information specific to Soldier
 	void describe() const override;
   
   // return the battle cry for a Soldier
   std::string get_battle_cry() override;
+  
+  std::string get_type() const override
+    { return "Soldier"; }
 };
 
 #endif
@@ -0,0 +1,119 @@
+#include "Spatial_index.h"
+
+#include "Geometry.h"
+
+#include <cmath>
+#include <functional>
+#include <map>
+#include <string>
+
+using std::string;
+using std::function;
+using std::make_pair;
+using std::fabs; using std::floor;
+
+// width of each square grid cell
+const double CELL_SIZE = 10.0;
+
+// add the named object, or move it if it is already present
+void Spatial_index::insert(const string& name, Point location)
+{
+  auto itr = locations.find(&name);
+  if (itr != locations.end()) {
+    Cell_t old_cell = get_cell(itr->second);
+    Cell_t new_cell = get_cell(location);
+    itr->second = location;
+    
+    // Most moves stay inside one cell.
+    if (old_cell == new_cell) {
+      cells[new_cell][itr->first] = location;
+      return;
+    }
+    
+    auto cell_itr = cells.find(old_cell);
+    cell_itr->second.erase(itr->first);
+    if (cell_itr->second.empty()) {
+      cells.erase(cell_itr);
+    }
+    cells[new_cell][itr->first] = location;
+    return;
+  }
+  
+  locations[&name] = location;
+  cells[get_cell(location)][&name] = location;
+}
+
+// remove the named object; no error if the name is not present
+void Spatial_index::remove(const string& name)
+{
+  auto itr = locations.find(&name);
+  if (itr == locations.end()) {
+    return;
+  }
+  
+  auto cell_itr = cells.find(get_cell(itr->second));
+  cell_itr->second.erase(itr->first);
+  if (cell_itr->second.empty()) {
+    cells.erase(cell_itr);
+  }
+  locations.erase(itr);
+}
+
+// if the named object is present, set location to where it is and return true
+bool Spatial_index::find(const string& name, Point& location) const
+{
+  auto itr = locations.find(&name);
+  if (itr == locations.end()) {
+    return false;
+  }
+  location = itr->second;
+  return true;
+}
+
+// call func with the name and location of every object in the square of
+// half-width range around center
+void Spatial_index::for_each_in_square(Point center, double range,
+                                       function<void(const string&, Point)> func) const
+{
+  double lower_x = floor((center.x - range) / CELL_SIZE);
+  double upper_x = floor((center.x + range) / CELL_SIZE);
+  
+  // If the square spans more columns than there are occupied cells, just check them all.
+  if (upper_x - lower_x >= cells.size()) {
+    for (auto &cell : cells) {
+      for (auto &object : cell.second) {
+        if (in_square(object.second, center, range)) {
+          func(*object.first, object.second);
+        }
+      }
+    }
+    return;
+  }
+  
+  // Otherwise visit the occupied cells of each overlapping column in order.
+  int lower_y = int(floor((center.y - range) / CELL_SIZE));
+  int upper_y = int(floor((center.y + range) / CELL_SIZE));
+  for (int x = int(lower_x); x <= int(upper_x); ++x) {
+    auto itr = cells.lower_bound(make_pair(x, lower_y));
+    auto end = cells.upper_bound(make_pair(x, upper_y));
+    for (; itr != end; ++itr) {
+      for (auto &object : itr->second) {
+        if (in_square(object.second, center, range)) {
+          func(*object.first, object.second);
+        }
+      }
+    }
+  }
+}
+
+// the cell that holds the location
+Spatial_index::Cell_t Spatial_index::get_cell(Point location)
+{
+  return make_pair(int(floor(location.x / CELL_SIZE)), int(floor(location.y / CELL_SIZE)));
+}
+
+// is the location inside the square of half-width range around center?
+bool in_square(Point location, Point center, double range)
+{
+  return fabs(location.x - center.x) <= range && fabs(location.y - center.y) <= range;
+}
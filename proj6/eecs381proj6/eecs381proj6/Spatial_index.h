@@ -0,0 +1,58 @@
+#ifndef SPATIAL_INDEX_H_
+#define SPATIAL_INDEX_H_
+
+/*
+ 
+ * Spatial_index class *
+ 
+ Spatial_index keeps the last known location of each named object,
+ bucketed into a uniform grid of square cells. Looking up everything
+ inside a square area only visits the cells that overlap it, so the
+ cost depends on how much is in the area rather than on the size of
+ the world.
+ 
+*/
+
+#include "Geometry.h"
+#include "Utility.h"
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+
+class Spatial_index {
+public:
+  
+  // add the named object, or move it if it is already present; only a pointer to
+  // the name is kept, so it must be one that lasts, such as the object's own name
+  void insert(const std::string& name, Point location);
+  
+  // remove the named object; no error if the name is not present
+  void remove(const std::string& name);
+  
+  // if the named object is present, set location to where it is and return true
+  bool find(const std::string& name, Point& location) const;
+  
+  // call func with the name and location of every object in the square of
+  // half-width range around center
+  void for_each_in_square(Point center, double range,
+                          std::function<void(const std::string&, Point)> func) const;
+  
+private:
+  using Cell_t = std::pair<int, int>;
+  using Cell_contents_t = std::map<const std::string*, Point, Name_ptr_less>;
+  using Cells_t = std::map<Cell_t, Cell_contents_t>;
+  using Locations_t = std::map<const std::string*, Point, Name_ptr_less>;
+  
+  // the cell that holds the location
+  static Cell_t get_cell(Point location);
+  
+  Cells_t cells;
+  Locations_t locations;
+};
+
+// is the location inside the square of half-width range around center?
+bool in_square(Point location, Point center, double range);
+
+#endif
@@ -5,7 +5,7 @@
 #include <iostream>
 
 using std::string;
-using std::cout; using std::endl;
+using std::endl;
 
 Structure::Structure (const string& name_, Point location_) :
   Sim_object{name_}, location{location_} {}
@@ -15,7 +15,7 @@ Structure::~Structure () {}
 
 void Structure::describe() const
 {
-  cout << get_name() << " at " << location << endl;
+  Model::get().out() << get_name() << " at " << location << endl;
 }
 
 void Structure::broadcast_current_state()
@@ -29,6 +29,8 @@ public:
 	// fat interface for derived types
 	virtual double withdraw(double amount_to_get) { return 0.0; }
 	virtual void deposit(double amount_to_give) {}
+	// the amount of food on hand
+	virtual double get_amount() const { return 0.0; }
   
 private:
   Point location;
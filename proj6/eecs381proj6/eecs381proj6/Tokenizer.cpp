@@ -0,0 +1,142 @@
+#include "Tokenizer.h"
+
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using std::istream;
+using std::string;
+using std::strtol; using std::strtod;
+
+const string::size_type INITIAL_BUFFER_SIZE = 4096;
+
+Tokenizer::Tokenizer(istream& is_) :
+  is(is_), pos{0}
+{
+  buffer.reserve(INITIAL_BUFFER_SIZE);
+}
+
+// read the next whitespace separated word, false if the input has ended
+bool Tokenizer::read_word(string& word)
+{
+  if (!skip_whitespace()) {
+    return false;
+  }
+  auto start = pos;
+  while (pos < buffer.size() && !isspace(static_cast<unsigned char>(buffer[pos]))) {
+    ++pos;
+  }
+  word.assign(buffer, start, pos - start);
+  return true;
+}
+
+// an optional sign followed by digits
+bool Tokenizer::read_int(int& value)
+{
+  if (!skip_whitespace()) {
+    return false;
+  }
+  auto start = pos;
+  if (buffer[pos] == '+' || buffer[pos] == '-') {
+    ++pos;
+  }
+  if (!skip_digits()) {
+    return false;
+  }
+  
+  errno = 0;
+  long number = strtol(buffer.c_str() + start, nullptr, 10);
+  if (errno == ERANGE || number < INT_MIN || number > INT_MAX) {
+    return false;
+  }
+  value = static_cast<int>(number);
+  return true;
+}
+
+// an optional sign, digits with an optional decimal point, and an optional exponent;
+// a stream takes all of those characters and then fails if they aren't a whole number
+bool Tokenizer::read_double(double& value)
+{
+  if (!skip_whitespace()) {
+    return false;
+  }
+  auto start = pos;
+  if (buffer[pos] == '+' || buffer[pos] == '-') {
+    ++pos;
+  }
+  skip_digits();
+  if (pos < buffer.size() && buffer[pos] == '.') {
+    ++pos;
+    skip_digits();
+  }
+  if (pos < buffer.size() && (buffer[pos] == 'e' || buffer[pos] == 'E')) {
+    ++pos;
+    if (pos < buffer.size() && (buffer[pos] == '+' || buffer[pos] == '-')) {
+      ++pos;
+    }
+    skip_digits();
+  }
+  
+  if (pos == start) {
+    return false;
+  }
+  // parse a copy so that strtod can't read past what a stream would have taken
+  number.assign(buffer, start, pos - start);
+  char *end;
+  errno = 0;
+  value = strtod(number.c_str(), &end);
+  return end == number.c_str() + number.size() && errno != ERANGE;
+}
+
+// discard the rest of the current line, including its newline
+void Tokenizer::skip_line()
+{
+  if (pos == buffer.size() && !fill()) {
+    return;
+  }
+  auto newline = buffer.find('\n', pos);
+  pos = newline == string::npos ? buffer.size() : newline + 1;
+}
+
+// skip whitespace, reading more lines as needed; false if the input has ended
+bool Tokenizer::skip_whitespace()
+{
+  while (true) {
+    while (pos < buffer.size() && isspace(static_cast<unsigned char>(buffer[pos]))) {
+      ++pos;
+    }
+    if (pos < buffer.size()) {
+      return true;
+    }
+    if (!fill()) {
+      return false;
+    }
+  }
+}
+
+// read the next line into the buffer, keeping its newline; false if the input has ended
+bool Tokenizer::fill()
+{
+  pos = 0;
+  if (!getline(is, buffer)) {
+    buffer.clear();
+    return false;
+  }
+  if (!is.eof()) {
+    buffer += '\n';
+  }
+  return true;
+}
+
+// consume the digits at the current position, returning how many there were
+int Tokenizer::skip_digits()
+{
+  auto start = pos;
+  while (pos < buffer.size() && isdigit(static_cast<unsigned char>(buffer[pos]))) {
+    ++pos;
+  }
+  return static_cast<int>(pos - start);
+}
@@ -0,0 +1,48 @@
+#ifndef TOKENIZER_H_
+#define TOKENIZER_H_
+
+/*
+ 
+ * Tokenizer class *
+ 
+ Tokenizer reads commands from an input stream one line at a time into a
+ buffer that is reused for every line, and hands out words and numbers from
+ it. Words and numbers are read exactly as operator>> would read them, so a
+ command can still span lines or share a line with others, but there is no
+ stream formatting overhead per token.
+ 
+*/
+
+#include <iosfwd>
+#include <string>
+
+class Tokenizer {
+public:
+  Tokenizer(std::istream& is_);
+  
+  // read the next whitespace separated word, false if the input has ended
+  bool read_word(std::string& word);
+  
+  // read a number the way operator>> would, false if there isn't a valid one;
+  // as with a stream, the characters that were looked at are consumed either way
+  bool read_int(int& value);
+  bool read_double(double& value);
+  
+  // discard the rest of the current line, including its newline
+  void skip_line();
+  
+private:
+  // skip whitespace, reading more lines as needed; false if the input has ended
+  bool skip_whitespace();
+  // read the next line into the buffer; false if the input has ended
+  bool fill();
+  // consume the digits at the current position, returning how many there were
+  int skip_digits();
+  
+  std::istream& is;
+  std::string buffer;
+  std::string::size_type pos;
+  std::string number;       // scratch space for read_double
+};
+
+#endif
@@ -7,7 +7,7 @@
 #include <string>
 
 using std::string;
-using std::cout; using std::endl;
+using std::endl;
 
 const double TAX_RATE = 0.1;
 const double MINIMUM_FOOD_AMOUNT = 1.0;
@@ -42,9 +42,9 @@ double Town_Hall::withdraw(double amount_to_obtain)
 }
 
 void Town_Hall::describe() const {
-  cout << "Town_Hall ";
+  Model::get().out() << "Town_Hall ";
   Structure::describe();
-  cout << "   Contains " << total_food << endl;
+  Model::get().out() << "   Contains " << total_food << endl;
 }
 
 void Town_Hall::broadcast_current_state()
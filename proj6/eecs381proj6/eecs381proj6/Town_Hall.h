@@ -23,6 +23,8 @@ public:
 	// update the amount on hand by subtracting the amount returned.
 	double withdraw(double amount_to_obtain) override;
   
+	double get_amount() const override { return total_food; }
+  
 	// output information about the current state
 	void describe() const override;
   
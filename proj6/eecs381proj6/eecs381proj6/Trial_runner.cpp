@@ -0,0 +1,107 @@
+#include "Trial_runner.h"
+
+#include "AgentIndividual.h"
+#include "Model.h"
+#include "Scenario_loader.h"
+#include "Sim_object.h"
+#include "Structure.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::cout; using std::endl;
+using std::ostream; using std::istringstream;
+using std::string; using std::vector;
+using std::shared_ptr; using std::dynamic_pointer_cast;
+using std::atomic; using std::thread;
+using std::min; using std::max;
+
+// what a world ended up with, or why it didn't get there
+struct Trial_result {
+  string error;
+  int agents;
+  int structures;
+  double food;
+};
+
+// run one trial in a world of its own, made current for this thread only
+Trial_result run_trial(const string& scenario, int trial, int ticks)
+{
+  Trial_result result{string(), 0, 0, 0.0};
+  // A stream without a buffer quietly drops everything written to it.
+  ostream no_output(nullptr);
+  Model world(no_output);
+  Model::Scope scope(world);
+  try {
+    istringstream is(scenario);
+    load_scenario(is, trial);
+    for (int tick = 0; tick < ticks; ++tick)
+      world.update();
+  } catch (Error& e) {
+    result.error = e.msg;
+    return result;
+  }
+  
+  world.synchronize();
+  world.for_each_object([&result](const shared_ptr<Sim_object>& object) {
+    if (auto structure = dynamic_pointer_cast<Structure>(object)) {
+      ++result.structures;
+      result.food += structure->get_amount();
+    } else if (auto agent = dynamic_pointer_cast<AgentIndividual>(object)) {
+      result.agents += agent->is_alive();
+    }
+  });
+  return result;
+}
+
+void run_trials(const string& scenario, int count, int ticks)
+{
+  if (count < 1) {
+    throw Error("Number of trials must be positive!");
+  }
+  if (ticks < 0) {
+    throw Error("Number of ticks must not be negative!");
+  }
+  
+  // Each thread takes the next trial nobody has started until they are all done.
+  vector<Trial_result> results(count);
+  atomic<int> next_trial{0};
+  int workers = min(count, max(1, int(thread::hardware_concurrency())));
+  vector<thread> threads;
+  for (int worker = 0; worker < workers; ++worker) {
+    threads.emplace_back([&]() {
+      for (int trial = next_trial++; trial < count; trial = next_trial++)
+        results[trial] = run_trial(scenario, trial, ticks);
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  
+  int completed = 0;
+  double agents = 0.0, structures = 0.0, food = 0.0;
+  for (int trial = 0; trial < count; ++trial) {
+    const Trial_result& result = results[trial];
+    cout << "Trial " << trial << ": ";
+    if (!result.error.empty()) {
+      cout << result.error << endl;
+      continue;
+    }
+    cout << result.agents << " agents, " << result.structures << " structures, "
+         << result.food << " food" << endl;
+    ++completed;
+    agents += result.agents;
+    structures += result.structures;
+    food += result.food;
+  }
+  if (completed) {
+    cout << "Mean: " << agents / completed << " agents, " << structures / completed
+         << " structures, " << food / completed << " food" << endl;
+  }
+}
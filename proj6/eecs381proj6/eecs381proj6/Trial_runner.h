@@ -0,0 +1,22 @@
+#ifndef TRIAL_RUNNER_H_
+#define TRIAL_RUNNER_H_
+
+/*
+ 
+ A batch of trials runs one scenario over and over, each time in a new world of its
+ own with the scenario's seeds shifted by the trial number, for Monte Carlo runs and
+ parameter sweeps. The worlds run on a pool of threads, one per hardware thread, and
+ their messages are discarded. Each world starts with the same initial objects as the
+ main one, so trial 0 ends up just as loading the scenario and going that many times
+ would leave the main world, which the trials don't touch.
+ 
+*/
+
+#include <string>
+
+// Run count trials of the scenario text for ticks ticks each, and print what each
+// ended up with and the mean. A trial whose scenario is malformed reports the error.
+// Throws Error if the count or ticks are out of range.
+void run_trials(const std::string& scenario, int count, int ticks);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef UTILITY_H_
 #define UTILITY_H_
 
+#include <functional>
 #include <string>
 
 /* Utility functions and classes used by other modules */
@@ -13,5 +14,21 @@ struct Error {
 	const std::string msg;
 };
 
+// Compare and hash pointers to names by the names they point to, so that a container
+// can be keyed by the name an object already holds instead of a copy of it. The name
+// must outlive its entry; a lookup can use the address of any string.
+struct Name_ptr_less {
+  bool operator() (const std::string* a, const std::string* b) const
+    { return *a < *b; }
+};
+struct Name_ptr_hash {
+  std::size_t operator() (const std::string* name) const
+    { return std::hash<std::string>()(*name); }
+};
+struct Name_ptr_equal {
+  bool operator() (const std::string* a, const std::string* b) const
+    { return *a == *b; }
+};
+
 #endif
 
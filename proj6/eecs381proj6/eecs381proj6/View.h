@@ -34,6 +34,12 @@ public:
 	
 	// discards the view's contents
 	virtual void clear() = 0;
+  
+  // A view that only shows the area around one object returns true and supplies the
+  // object's name and how far from it the view can see. Model then only sends it
+  // locations from inside that area. By default a view sees the whole world.
+  virtual bool get_followed_area(std::string& name, double& range) const
+    { return false; }
 };
 
 #endif
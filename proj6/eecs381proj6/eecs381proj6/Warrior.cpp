@@ -8,7 +8,7 @@
 #include <cassert>
 
 using std::string;
-using std::cout; using std::endl;
+using std::endl;
 using std::shared_ptr;
 
 Warrior::Warrior(const string& name_, Point location_, int strength_, double range_) :
@@ -25,43 +25,42 @@ void Warrior::update()
 {
   AgentIndividual::update();
   
-  // Do nothing if we aren't attacking.
-  if (!is_attacking()) {
+  // Do nothing if we are dead or aren't attacking.
+  if (!is_alive() || !is_attacking()) {
     return;
   }
   
   // Check if our target no longer exists or is dead.
-  shared_ptr<AgentComponent> target_ptr = target.lock();
-  if (!target_ptr) {
-    cout << get_name() << ": Target is dead" << endl;
+  AgentComponent* target_ptr = Model::get().get_agent(target);
+  if (!target_ptr || !target_ptr->is_alive()) {
+    Model::get().out() << get_name() << ": Target is dead" << endl;
     clear_attack();
     return;
   }
   
   // Check if the target is still in range.
-  auto closest_indv = target_ptr->get_nearest_in_range(shared_from_this(), attack_range);
+  auto closest_indv = target_ptr->get_nearest_in_range(*this, attack_range);
   if (!closest_indv) {
-    cout << get_name() << ": Target is now out of range" << endl;
+    Model::get().out() << get_name() << ": Target is now out of range" << endl;
     clear_attack();
     return;
   }
   
   // Attack!
-  cout << get_name() << ": " << get_battle_cry() << endl;
-  closest_indv->take_hit(attack_strength, shared_from_this());
+  Model::get().out() << get_name() << ": " << get_battle_cry() << endl;
+  closest_indv->take_hit(attack_strength, *this);
   
   // Did we just kill it?
   if (!closest_indv->is_alive()) {
-    cout << get_name() << ": I triumph!" << endl;
-    auto old_target = target_ptr;
+    Model::get().out() << get_name() << ": I triumph!" << endl;
     Model::get().notify_end_attack(get_name());
     
-    closest_indv = target_ptr->get_nearest_in_range(shared_from_this(), attack_range);
+    closest_indv = target_ptr->get_nearest_in_range(*this, attack_range);
     if (!closest_indv || !closest_indv->is_alive()) {
       // nobody in group in range
       clear_attack();
     } else {
-      attack(old_target);
+      attack(*target_ptr);
     }
   }
 }
@@ -69,9 +68,9 @@ void Warrior::update()
 // Make this Soldier start attacking the target AgentComponent.
 // Throws an exception if the target is the same as this AgentComponent,
 // is out of range, or is not alive.
-void Warrior::start_attacking(shared_ptr<AgentComponent> target_ptr)
+void Warrior::start_attacking(const shared_ptr<AgentComponent>& target_ptr)
 {
-  if (target_ptr == shared_from_this()) {    
+  if (target_ptr.get() == this) {
     throw Error( get_name() + ": I cannot attack myself!" );
   }
   
@@ -81,20 +80,22 @@ void Warrior::start_attacking(shared_ptr<AgentComponent> target_ptr)
   }
   
   // Check that there is anyone in range.
-  auto closest_indv = target_ptr->get_nearest_in_range(shared_from_this(), attack_range);
+  auto closest_indv = target_ptr->get_nearest_in_range(*this, attack_range);
   if (!closest_indv) {
     throw Error( get_name() + ": No one in range!" );
   }
   
-  attack(target_ptr);
+  attack(*target_ptr);
+  // Anyone this attack can reach, ourselves included, has to be on the full schedule.
+  Model::get().end_coarse_near(get_location(), attack_range);
   Model::get().notify_attack(get_name(), closest_indv->get_name());
 }
 
 // Attack the given agent, regardless of if its status (in range, alive, etc.)
-void Warrior::attack(shared_ptr<AgentComponent> target_ptr)
+void Warrior::attack(const AgentComponent& target_ptr)
 {
-  cout << get_name() << ": I'm attacking!" << endl;
-  target = target_ptr;
+  Model::get().out() << get_name() << ": I'm attacking!" << endl;
+  target = Model::get().get_agent_handle(target_ptr.get_name());
   attacking = true;
 }
 
@@ -103,12 +104,12 @@ void Warrior::clear_attack()
 {
   Model::get().notify_end_attack(get_name());
   attacking = false;
-  target.reset();
+  target = Agent_handle();
 }
 
 void Warrior::stop()
 {
-  cout << get_name() << ": Don't bother me" << endl;
+  Model::get().out() << get_name() << ": Don't bother me" << endl;
 }
 
 // output information about the current state
@@ -117,14 +118,14 @@ void Warrior::describe() const
   AgentIndividual::describe();
   
   if (is_attacking()) {
-    shared_ptr<AgentComponent> target_ptr = target.lock();
+    AgentComponent* target_ptr = Model::get().get_agent(target);
     if (target_ptr) {
-      cout << "   Attacking " << target_ptr->get_printed_name() << endl;
+      Model::get().out() << "   Attacking " << target_ptr->get_printed_name() << endl;
     } else {
-      cout << "   Attacking dead target" << endl;
+      Model::get().out() << "   Attacking dead target" << endl;
     }
   } else {
-    cout << "   Not attacking" << endl;
+    Model::get().out() << "   Not attacking" << endl;
   }
 }
 
@@ -132,10 +133,10 @@ void Warrior::broadcast_current_state()
 {
   AgentIndividual::broadcast_current_state();
   
-  // We shouldn't need the target expired check here; more for sanity's sake.
-  if (is_attacking() && !target.expired()) {
-    auto target_ptr = target.lock();
-    auto closest_in_range = target_ptr->get_nearest_in_range(shared_from_this(), attack_range);
+  // We shouldn't need the target check here; more for sanity's sake.
+  AgentComponent* target_ptr = Model::get().get_agent(target);
+  if (is_attacking() && target_ptr) {
+    auto closest_in_range = target_ptr->get_nearest_in_range(*this, attack_range);
     if (closest_in_range) {
       Model::get().notify_attack(get_name(), closest_in_range->get_name());
     }
@@ -8,6 +8,7 @@
 
 */
 
+#include "Agent_handle.h"
 #include "AgentIndividual.h"
 
 #include <memory>
@@ -25,10 +26,14 @@ public:
   // update implements a Warrior's general behavior
   void update() override;
   
+  // an attacking Warrior has to keep its full schedule
+  bool can_coarsen() const override
+    { return AgentIndividual::can_coarsen() && !is_attacking(); }
+  
   // Make this Warrior start attacking the target AgentComponent.
 	// Throws an exception if the target is the same as this AgentComponent,
 	// is out of range, or is not alive.
-  void start_attacking(std::shared_ptr<AgentComponent> target_ptr) override;
+  void start_attacking(const std::shared_ptr<AgentComponent>& target_ptr) override;
   
   // Overrides AgentComponent's stop to print a message
   void stop() override;
@@ -48,7 +53,7 @@ protected:
     { return attack_range; }
   
   // Attack the given agent, regardless of if its status (in range, alive, etc.)
-  void attack(std::shared_ptr<AgentComponent> target_ptr);
+  void attack(const AgentComponent& target_ptr);
   // attack is over, clear target and set state
   void clear_attack();
   
@@ -58,7 +63,8 @@ private:
   double attack_range;
   bool attacking;
   
-  std::weak_ptr<AgentComponent> target;
+  // checked against the Model's agent table each time it is used
+  Agent_handle target;
   
   // Ask subclasses for their battle cry.
   virtual std::string get_battle_cry() = 0;